@@ -0,0 +1,202 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#if __has_include(<memory_resource>)
+# include <memory_resource>
+#endif
+
+
+namespace senoval
+{
+/**
+ * A monotonic bump-pointer allocator over an inline buffer, for scratch memory that is released all at once.
+ * An allocation is an alignment adjustment and an addition; individual blocks are never freed.
+ * Use getMark()/rewind() to release everything allocated after a certain point, e.g., per request:
+ *
+ *      const auto mark = arena.getMark();
+ *      auto* buffer = arena.allocate(n);
+ *      ...
+ *      arena.rewind(mark);
+ *
+ * The arena does not run destructors, so construct() is meant for trivially destructible types;
+ * other objects shall be destroyed manually before their memory is rewound.
+ * See ArenaResource for use with the std::pmr containers.
+ */
+template <std::size_t Bytes_>
+class Arena
+{
+public:
+    static constexpr std::size_t Bytes = Bytes_;
+
+    static_assert(Bytes > 0, "Capacity must be positive");
+
+    /// Opaque position of the arena; only valid with the arena that returned it.
+    class Mark
+    {
+        friend class Arena;
+        std::size_t offset_ = 0;
+        explicit constexpr Mark(const std::size_t offset) : offset_(offset) { }
+    public:
+        constexpr Mark() = default;
+    };
+
+private:
+    alignas(std::max_align_t) unsigned char buf_[Bytes];    // Not initialized
+    detail::SmallestUnsignedFor<Bytes> used_ = 0;
+    detail::SmallestUnsignedFor<Bytes> watermark_ = 0;
+
+public:
+    Arena() = default;
+
+    // The allocations point into the buffer, so the arena must stay where it is.
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /// Uninitialized memory, or nullptr if there is not enough space. The alignment shall be a power of two.
+    [[nodiscard]]
+    void* allocate(const std::size_t size, const std::size_t alignment = alignof(std::max_align_t))
+    {
+        assert((alignment > 0) && ((alignment & (alignment - 1U)) == 0));
+        // The address is aligned rather than the offset, since the alignment may exceed that of the buffer.
+        const auto base = reinterpret_cast<std::uintptr_t>(&buf_[0]);
+        const std::uintptr_t aligned = (base + used_ + (alignment - 1U)) & ~std::uintptr_t(alignment - 1U);
+        const std::size_t offset = std::size_t(aligned - base);
+        if ((offset > Bytes) || (size > (Bytes - offset)))
+        {
+            return nullptr;
+        }
+        used_ = decltype(used_)(offset + size);
+        watermark_ = (used_ > watermark_) ? used_ : watermark_;
+        return &buf_[offset];
+    }
+
+    /// Allocates and constructs an object; returns nullptr if there is not enough space.
+    template <typename T, typename... Args>
+    [[nodiscard]]
+    T* construct(Args&&... args)
+    {
+        void* const p = allocate(sizeof(T), alignof(T));
+        return (p == nullptr) ? nullptr : ::new (p) T(std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] Mark getMark() const { return Mark(used_); }
+
+    /// Releases everything that was allocated after the mark was taken.
+    void rewind(const Mark mark)
+    {
+        assert(mark.offset_ <= used_);
+        used_ = decltype(used_)((mark.offset_ <= used_) ? mark.offset_ : used_);
+    }
+
+    /// Releases everything.
+    void reset() { used_ = 0; }
+
+    /// True if the pointer points into the buffer of this arena.
+    [[nodiscard]]
+    bool owns(const void* const pointer) const
+    {
+        const auto p = reinterpret_cast<std::uintptr_t>(pointer);
+        const auto base = reinterpret_cast<std::uintptr_t>(&buf_[0]);
+        return (p >= base) && (p < (base + Bytes));
+    }
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return Bytes; }
+
+    /// The number of bytes in use, including the alignment padding.
+    [[nodiscard]] std::size_t size() const { return used_; }
+
+    [[nodiscard]] // nodiscard prevents confusion with reset()
+    bool empty() const { return used_ == 0; }
+
+    /// The largest number of bytes that have been in use at the same time since the arena was constructed.
+    [[nodiscard]] std::size_t getHighWatermark() const { return watermark_; }
+};
+
+#if defined(__cpp_lib_memory_resource)
+/**
+ * Adapts an Arena for the std::pmr containers:
+ *
+ *      Arena<4096> arena;
+ *      ArenaResource resource(arena);
+ *      std::pmr::vector<int> vec(&resource);
+ *
+ * Deallocation is a no-op, like in std::pmr::monotonic_buffer_resource; rewind the arena once the containers
+ * are gone. When the arena is exhausted, the request is forwarded to the upstream resource. The default upstream
+ * is std::pmr::null_memory_resource(), which throws std::bad_alloc, so the global heap is never touched.
+ */
+template <std::size_t Bytes>
+class ArenaResource final : public std::pmr::memory_resource
+{
+    Arena<Bytes>& arena_;
+    std::pmr::memory_resource* const upstream_;
+
+public:
+    explicit ArenaResource(Arena<Bytes>& arena,
+                           std::pmr::memory_resource* const upstream = std::pmr::null_memory_resource()) :
+        arena_(arena),
+        upstream_(upstream)
+    {
+        assert(upstream_ != nullptr);
+    }
+
+    [[nodiscard]] Arena<Bytes>& getArena() const { return arena_; }
+
+private:
+    void* do_allocate(const std::size_t bytes, const std::size_t alignment) override
+    {
+        void* const p = arena_.allocate(bytes, alignment);
+        return (p != nullptr) ? p : upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* const p, const std::size_t bytes, const std::size_t alignment) override
+    {
+        if (!arena_.owns(p))
+        {
+            upstream_->deallocate(p, bytes, alignment);
+        }
+    }
+
+    [[nodiscard]]
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+#endif
+
+}
@@ -0,0 +1,388 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace senoval
+{
+namespace detail
+{
+/// The natural word of the target; on 32-bit MCUs the 64-bit operations would be emulated.
+using BitsetWord = std::conditional_t<(sizeof(void*) >= 8), std::uint64_t, std::uint32_t>;
+
+constexpr std::size_t BitsetWordBits = sizeof(BitsetWord) * 8U;
+
+/*
+ * The builtins map to single instructions where available (POPCNT, TZCNT/BSF, CLZ and RBIT+CLZ on ARM)
+ * and are usable in constant expressions. The argument of the ctz/clz functions shall not be zero.
+ * The words that fit into an int use the int variants, since the long long ones are emulated on 32-bit targets.
+ */
+constexpr std::size_t countOnes(const BitsetWord x)
+{
+#if defined(__GNUC__)
+    if constexpr (sizeof(BitsetWord) <= sizeof(unsigned))
+    {
+        return std::size_t(__builtin_popcount(unsigned(x)));
+    }
+    else
+    {
+        return std::size_t(__builtin_popcountll(x));
+    }
+#else
+    std::size_t n = 0;
+    for (BitsetWord v = x; v != 0; v &= v - 1U)
+    {
+        n++;
+    }
+    return n;
+#endif
+}
+
+constexpr std::size_t countTrailingZeros(const BitsetWord x)
+{
+#if defined(__GNUC__)
+    if constexpr (sizeof(BitsetWord) <= sizeof(unsigned))
+    {
+        return std::size_t(__builtin_ctz(unsigned(x)));
+    }
+    else
+    {
+        return std::size_t(__builtin_ctzll(x));
+    }
+#else
+    std::size_t n = 0;
+    while (((x >> n) & 1U) == 0)
+    {
+        n++;
+    }
+    return n;
+#endif
+}
+
+constexpr std::size_t countLeadingZeros(const BitsetWord x)
+{
+#if defined(__GNUC__)
+    if constexpr (sizeof(BitsetWord) <= sizeof(unsigned))
+    {
+        return std::size_t(__builtin_clz(unsigned(x))) - ((sizeof(unsigned) - sizeof(BitsetWord)) * 8U);
+    }
+    else
+    {
+        return std::size_t(__builtin_clzll(x)) - ((sizeof(unsigned long long) - sizeof(BitsetWord)) * 8U);
+    }
+#else
+    std::size_t n = 0;
+    while (((x << n) & (BitsetWord(1) << (BitsetWordBits - 1U))) == 0)
+    {
+        n++;
+    }
+    return n;
+#endif
+}
+
+}
+
+/**
+ * A fixed-size set of bits, API like std::bitset<> with some extensions, usable in constant expressions.
+ * The bits are packed into native words; counting and searching use the hardware instructions where available.
+ * The unused bits of the last word are always kept zero.
+ *
+ * Iterating over the set bits:
+ *
+ *      for (auto i = bits.findFirst(); i < bits.size(); i = bits.findNext(i)) { ... }
+ */
+template <std::size_t N>
+class Bitset
+{
+    using Word = detail::BitsetWord;
+    static constexpr std::size_t WordBits = detail::BitsetWordBits;
+    static constexpr std::size_t Words = (N + WordBits - 1U) / WordBits;
+    static constexpr Word LastWordMask =
+        ((N % WordBits) == 0) ? ~Word(0) : Word((Word(1) << (N % WordBits)) - 1U);
+
+    Word words_[(Words > 0) ? Words : 1]{};
+
+    constexpr void trimLastWord()
+    {
+        if constexpr (Words > 0)
+        {
+            words_[Words - 1U] &= LastWordMask;
+        }
+        else
+        {
+            words_[0] = 0;      // The dummy word of the empty set shall not contribute to count() and the like
+        }
+    }
+
+public:
+    /// Returned by the search functions if there is no such bit; equals size().
+    static constexpr std::size_t npos = N;
+
+    constexpr Bitset() = default;
+
+    /// The low bits of the value; like std::bitset, implicit.
+    constexpr Bitset(const unsigned long long value)  // NOLINT
+    {
+        for (std::size_t i = 0; (i < Words) && ((i * WordBits) < 64U); i++)
+        {
+            words_[i] = Word(value >> (i * WordBits));
+        }
+        trimLastWord();
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const { return N; }
+
+    [[nodiscard]]
+    constexpr bool test(const std::size_t index) const
+    {
+        assert(index < N);
+        return ((words_[index / WordBits] >> (index % WordBits)) & 1U) != 0;
+    }
+
+    [[nodiscard]] constexpr bool operator[](const std::size_t index) const { return test(index); }
+
+    constexpr Bitset& set(const std::size_t index, const bool value = true)
+    {
+        assert(index < N);
+        const Word mask = Word(Word(1) << (index % WordBits));
+        Word& w = words_[index / WordBits];
+        w = value ? (w | mask) : (w & ~mask);
+        return *this;
+    }
+
+    constexpr Bitset& reset(const std::size_t index) { return set(index, false); }
+
+    constexpr Bitset& flip(const std::size_t index)
+    {
+        assert(index < N);
+        words_[index / WordBits] ^= Word(Word(1) << (index % WordBits));
+        return *this;
+    }
+
+    constexpr Bitset& set()
+    {
+        for (Word& w : words_)
+        {
+            w = ~Word(0);
+        }
+        trimLastWord();
+        return *this;
+    }
+
+    constexpr Bitset& reset()
+    {
+        for (Word& w : words_)
+        {
+            w = 0;
+        }
+        return *this;
+    }
+
+    constexpr Bitset& flip()
+    {
+        for (Word& w : words_)
+        {
+            w = Word(~w);
+        }
+        trimLastWord();
+        return *this;
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t count() const
+    {
+        std::size_t n = 0;
+        for (const Word w : words_)
+        {
+            n += detail::countOnes(w);
+        }
+        return n;
+    }
+
+    [[nodiscard]] constexpr bool any()  const { return findFirst() < N; }
+    [[nodiscard]] constexpr bool none() const { return !any(); }
+    [[nodiscard]] constexpr bool all()  const { return count() == N; }
+
+    /*
+     * Search. Each function returns the index of the bit or npos.
+     */
+    [[nodiscard]]
+    constexpr std::size_t findFirst() const
+    {
+        for (std::size_t i = 0; i < Words; i++)
+        {
+            if (words_[i] != 0)
+            {
+                return (i * WordBits) + detail::countTrailingZeros(words_[i]);
+            }
+        }
+        return npos;
+    }
+
+    /// The first set bit after the index; the index itself is not included.
+    [[nodiscard]]
+    constexpr std::size_t findNext(const std::size_t index) const
+    {
+        const std::size_t start = index + 1U;
+        if (start >= N)
+        {
+            return npos;
+        }
+        std::size_t i = start / WordBits;
+        Word w = Word(words_[i] & (~Word(0) << (start % WordBits)));
+        while (w == 0)
+        {
+            if (++i >= Words)
+            {
+                return npos;
+            }
+            w = words_[i];
+        }
+        return (i * WordBits) + detail::countTrailingZeros(w);
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t findLast() const
+    {
+        for (std::size_t i = Words; i > 0; i--)
+        {
+            if (words_[i - 1U] != 0)
+            {
+                return (i * WordBits) - 1U - detail::countLeadingZeros(words_[i - 1U]);
+            }
+        }
+        return npos;
+    }
+
+    /// The first clear bit, e.g., a free slot in an occupancy map.
+    [[nodiscard]]
+    constexpr std::size_t findFirstClear() const
+    {
+        for (std::size_t i = 0; i < Words; i++)
+        {
+            const Word inverted = Word(~words_[i]) & ((i == (Words - 1U)) ? LastWordMask : ~Word(0));
+            if (inverted != 0)
+            {
+                return (i * WordBits) + detail::countTrailingZeros(inverted);
+            }
+        }
+        return npos;
+    }
+
+    /*
+     * Bulk operations, one word at a time.
+     */
+    constexpr Bitset& operator&=(const Bitset& other)
+    {
+        for (std::size_t i = 0; i < Words; i++)
+        {
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+
+    constexpr Bitset& operator|=(const Bitset& other)
+    {
+        for (std::size_t i = 0; i < Words; i++)
+        {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+
+    constexpr Bitset& operator^=(const Bitset& other)
+    {
+        for (std::size_t i = 0; i < Words; i++)
+        {
+            words_[i] ^= other.words_[i];
+        }
+        return *this;
+    }
+
+    [[nodiscard]] constexpr Bitset operator~() const { return Bitset(*this).flip(); }
+
+    [[nodiscard]]
+    friend constexpr Bitset operator&(Bitset left, const Bitset& right) { return left &= right; }
+
+    [[nodiscard]]
+    friend constexpr Bitset operator|(Bitset left, const Bitset& right) { return left |= right; }
+
+    [[nodiscard]]
+    friend constexpr Bitset operator^(Bitset left, const Bitset& right) { return left ^= right; }
+
+    [[nodiscard]]
+    friend constexpr bool operator==(const Bitset& left, const Bitset& right)
+    {
+        for (std::size_t i = 0; i < Words; i++)
+        {
+            if (left.words_[i] != right.words_[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]]
+    friend constexpr bool operator!=(const Bitset& left, const Bitset& right) { return !(left == right); }
+
+    /// True if all bits that are set in the argument are also set here.
+    [[nodiscard]]
+    constexpr bool contains(const Bitset& other) const
+    {
+        for (std::size_t i = 0; i < Words; i++)
+        {
+            if ((other.words_[i] & ~words_[i]) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// The low bits; the bits that do not fit are ignored.
+    [[nodiscard]]
+    constexpr unsigned long long to_ullong() const
+    {
+        unsigned long long out = 0;
+        for (std::size_t i = 0; (i < Words) && ((i * WordBits) < 64U); i++)
+        {
+            out |= static_cast<unsigned long long>(words_[i]) << (i * WordBits);
+        }
+        return out;
+    }
+};
+
+}
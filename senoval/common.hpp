@@ -0,0 +1,358 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+/**
+ * The data shared between threads is aligned to this boundary in order to avoid false sharing.
+ * On microcontrollers there is nothing to gain, so the default is 1, which means no padding.
+ * Define this macro before including the library to override the default.
+ */
+#ifndef SENOVAL_CACHE_LINE_SIZE
+# if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__) || defined(_M_X64) || defined(_M_IX86)
+#  define SENOVAL_CACHE_LINE_SIZE 64
+# else
+#  define SENOVAL_CACHE_LINE_SIZE 1
+# endif
+#endif
+
+/**
+ * Availability of the compiler builtins behind detail::isConstantEvaluated() and detail::bitCast().
+ * Define these macros to 0 or 1 before including the library to override the detection.
+ */
+#ifndef SENOVAL_HAS_IS_CONSTANT_EVALUATED
+# if defined(__has_builtin)
+#  if __has_builtin(__builtin_is_constant_evaluated)
+#   define SENOVAL_HAS_IS_CONSTANT_EVALUATED 1
+#  endif
+# elif defined(__GNUC__) && (__GNUC__ >= 9)
+#  define SENOVAL_HAS_IS_CONSTANT_EVALUATED 1
+# endif
+# ifndef SENOVAL_HAS_IS_CONSTANT_EVALUATED
+#  define SENOVAL_HAS_IS_CONSTANT_EVALUATED 0
+# endif
+#endif
+
+#ifndef SENOVAL_HAS_BUILTIN_BIT_CAST
+# if defined(__has_builtin)
+#  if __has_builtin(__builtin_bit_cast)
+#   define SENOVAL_HAS_BUILTIN_BIT_CAST 1
+#  endif
+# endif
+# ifndef SENOVAL_HAS_BUILTIN_BIT_CAST
+#  define SENOVAL_HAS_BUILTIN_BIT_CAST 0
+# endif
+#endif
+
+/**
+ * Internal infrastructure shared by the headers of the library. Not part of the public API.
+ */
+namespace senoval
+{
+namespace detail
+{
+/**
+ * Like std::is_constant_evaluated() from C++20. Allows us to use fast library functions at run time
+ * and plain loops in constant expressions.
+ * If the compiler does not provide the builtin, the constexpr-friendly path is always taken.
+ */
+constexpr bool isConstantEvaluated()
+{
+#if SENOVAL_HAS_IS_CONSTANT_EVALUATED
+    return __builtin_is_constant_evaluated();
+#else
+    return true;
+#endif
+}
+
+/**
+ * Like std::bit_cast() from C++20. Usable in constant expressions if the compiler provides the builtin;
+ * otherwise it is a memcpy(), which the compiler reduces to a register move.
+ */
+template <typename To, typename From>
+constexpr To bitCast(const From& from)
+{
+    static_assert(sizeof(To) == sizeof(From), "The sizes shall match");
+    static_assert(std::is_trivially_copyable_v<To> && std::is_trivially_copyable_v<From>,
+                  "Only trivially copyable types can be reinterpreted");
+#if SENOVAL_HAS_BUILTIN_BIT_CAST
+    return __builtin_bit_cast(To, from);
+#else
+    To out{};
+    std::memcpy(&out, &from, sizeof(To));
+    return out;
+#endif
+}
+
+
+/// memcmp() == 0 that can be used in constant expressions.
+constexpr bool equalChars(const char* const a, const char* const b, const std::size_t count)
+{
+    if (isConstantEvaluated())
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (a[i] != b[i])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    return (count == 0) || (std::memcmp(a, b, count) == 0);
+}
+
+/**
+ * 32-bit FNV-1a. The result does not depend on the platform, so it can be computed at compile time,
+ * stored, or transmitted. It is not resistant to collision attacks.
+ */
+constexpr std::uint32_t computeFNV1aHash(const char* const s, const std::size_t count)
+{
+    std::uint32_t hash = 2166136261U;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        hash = (hash ^ static_cast<std::uint8_t>(s[i])) * 16777619U;
+    }
+    return hash;
+}
+
+/**
+ * The smallest unsigned integer type that can represent the value.
+ * Used for the length fields of the containers; for small capacities this saves more than half of the object.
+ */
+template <std::size_t MaxValue>
+using SmallestUnsignedFor =
+    std::conditional_t<(MaxValue <= std::numeric_limits<std::uint8_t>::max()),  std::uint8_t,
+    std::conditional_t<(MaxValue <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t,
+    std::conditional_t<(MaxValue <= std::numeric_limits<std::uint32_t>::max()), std::uint32_t,
+                                                                                 std::size_t>>>;
+
+/**
+ * A pointer to a length field of any of the types produced by SmallestUnsignedFor<>.
+ * It allows the capacity-erased references (StringRef, VectorRef) to update the length of the referenced container
+ * while being compiled once for all capacities. The type is dispatched at run time; it is a single byte compare.
+ */
+class LengthRef
+{
+    template <std::uint8_t>
+    struct Tag {};
+
+    union Pointer
+    {
+        std::uint8_t*  u8;
+        std::uint16_t* u16;
+        std::uint32_t* u32;
+        std::size_t*   wide;
+
+        constexpr Pointer(Tag<0>, std::uint8_t*  const p) : u8(p)   { }
+        constexpr Pointer(Tag<1>, std::uint16_t* const p) : u16(p)  { }
+        constexpr Pointer(Tag<2>, std::uint32_t* const p) : u32(p)  { }
+        constexpr Pointer(Tag<3>, std::size_t*   const p) : wide(p) { }
+    };
+
+    template <typename L>
+    static constexpr std::uint8_t getKind()
+    {
+        static_assert(std::is_same_v<L, std::uint8_t>  || std::is_same_v<L, std::uint16_t> ||
+                      std::is_same_v<L, std::uint32_t> || std::is_same_v<L, std::size_t>,
+                      "The length type shall be one of SmallestUnsignedFor<>");
+        return std::is_same_v<L, std::uint8_t>  ? 0 :
+               std::is_same_v<L, std::uint16_t> ? 1 :
+               std::is_same_v<L, std::uint32_t> ? 2 : 3;
+    }
+
+    Pointer ptr_;
+    std::uint8_t kind_;
+
+public:
+    template <typename L>
+    constexpr explicit LengthRef(L* const length) :
+        ptr_(Tag<getKind<L>()>{}, length),
+        kind_(getKind<L>())
+    { }
+
+    [[nodiscard]]
+    constexpr std::size_t get() const
+    {
+        switch (kind_)
+        {
+        case 0:  return *ptr_.u8;
+        case 1:  return *ptr_.u16;
+        case 2:  return *ptr_.u32;
+        default: return *ptr_.wide;
+        }
+    }
+
+    /// The value shall not exceed the capacity of the container, so it always fits.
+    constexpr void set(const std::size_t value) const
+    {
+        switch (kind_)
+        {
+        case 0:  *ptr_.u8   = std::uint8_t(value);  break;
+        case 1:  *ptr_.u16  = std::uint16_t(value); break;
+        case 2:  *ptr_.u32  = std::uint32_t(value); break;
+        default: *ptr_.wide = value;                break;
+        }
+    }
+};
+
+/// The finalizer of MurmurHash3 truncated to 32 bits; spreads the entropy of the input into all bits of the output.
+constexpr std::uint32_t mixBits(std::uint64_t x)
+{
+    x ^= x >> 33U;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33U;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33U;
+    return std::uint32_t(x);
+}
+
+/// Alignment of the shared data of type T that keeps it in a separate cache line; never weaker than the natural one.
+template <typename T>
+inline constexpr std::size_t CacheLineAlignment =
+    (std::size_t(SENOVAL_CACHE_LINE_SIZE) > alignof(T)) ? std::size_t(SENOVAL_CACHE_LINE_SIZE) : alignof(T);
+
+/// Unlike std::tolower(), these do not depend on the locale, so they can be used in constant expressions.
+constexpr char toLowerCase(const char c)
+{
+    return ((c >= 'A') && (c <= 'Z')) ? char(c - 'A' + 'a') : c;
+}
+
+constexpr char toUpperCase(const char c)
+{
+    return ((c >= 'a') && (c <= 'z')) ? char(c - 'a' + 'A') : c;
+}
+
+/**
+ * ASCII case folding of a machine word at a time, without branches.
+ * The most significant bit of each byte is used as a flag that doesn't carry into the neighboring byte:
+ * the low seven bits are offset such that the flag is set iff the byte is within [First, Last].
+ * Non-ASCII bytes (MSB set) are never modified.
+ */
+using CaseFoldingWord = std::size_t;
+
+constexpr CaseFoldingWord replicateByte(const std::uint8_t value)
+{
+    return CaseFoldingWord(CaseFoldingWord(~CaseFoldingWord(0)) / 0xFFU) * value;
+}
+
+template <bool ToUpper>
+constexpr CaseFoldingWord foldCaseWord(const CaseFoldingWord w)
+{
+    constexpr std::uint8_t First = ToUpper ? 'a' : 'A';
+    constexpr std::uint8_t Last  = ToUpper ? 'z' : 'Z';
+    const CaseFoldingWord heptets = w & replicateByte(0x7FU);
+    const CaseFoldingWord above_first = heptets + replicateByte(std::uint8_t(0x80U - First));
+    const CaseFoldingWord above_last  = heptets + replicateByte(std::uint8_t(0x80U - Last - 1U));
+    const CaseFoldingWord in_range = above_first & ~above_last & ~w & replicateByte(0x80U);
+    return w ^ (in_range >> 2U);        // 0x80 >> 2 = 0x20, the case bit
+}
+
+/**
+ * Converts the case of ASCII letters; dst may be the same as src.
+ * If the maximum count is known statically, the kernels that are wider than that are not instantiated.
+ */
+template <bool ToUpper, std::size_t MaxCount = std::numeric_limits<std::size_t>::max()>
+constexpr void convertCase(char* const dst, const char* const src, const std::size_t count)
+{
+    std::size_t i = 0;
+    if (!isConstantEvaluated())
+    {
+#if defined(__SSE2__)
+        if constexpr (MaxCount >= sizeof(__m128i))
+        {
+            const __m128i first = _mm_set1_epi8(char((ToUpper ? 'a' : 'A') - 1));
+            const __m128i last  = _mm_set1_epi8(char((ToUpper ? 'z' : 'Z') + 1));
+            const __m128i bit   = _mm_set1_epi8(0x20);
+            for (; (i + sizeof(__m128i)) <= count; i += sizeof(__m128i))
+            {
+                // The comparison is signed, so the non-ASCII bytes are outside of the range.
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi8(v, first), _mm_cmplt_epi8(v, last));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(v, _mm_and_si128(in_range, bit)));
+            }
+        }
+#endif
+        if constexpr (MaxCount >= sizeof(CaseFoldingWord))
+        {
+            for (; (i + sizeof(CaseFoldingWord)) <= count; i += sizeof(CaseFoldingWord))
+            {
+                CaseFoldingWord w = 0;
+                std::memcpy(&w, src + i, sizeof(w));
+                w = foldCaseWord<ToUpper>(w);
+                std::memcpy(dst + i, &w, sizeof(w));
+            }
+        }
+    }
+    for (; i < count; i++)
+    {
+        dst[i] = ToUpper ? toUpperCase(src[i]) : toLowerCase(src[i]);
+    }
+}
+
+/// Case-insensitive ASCII comparison of two sequences of the same length.
+constexpr bool equalsIgnoreCase(const char* const a, const char* const b, const std::size_t count)
+{
+    std::size_t i = 0;
+    if (!isConstantEvaluated())
+    {
+        for (; (i + sizeof(CaseFoldingWord)) <= count; i += sizeof(CaseFoldingWord))
+        {
+            CaseFoldingWord x = 0;
+            CaseFoldingWord y = 0;
+            std::memcpy(&x, a + i, sizeof(x));
+            std::memcpy(&y, b + i, sizeof(y));
+            if ((x != y) && (foldCaseWord<false>(x) != foldCaseWord<false>(y)))
+            {
+                return false;
+            }
+        }
+    }
+    for (; i < count; i++)
+    {
+        if (toLowerCase(a[i]) != toLowerCase(b[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+}
@@ -29,12 +29,21 @@
 # error "This library requires C++17 or newer"
 #endif
 
+#include "common.hpp"
+#include <cassert>
 #include <cmath>
 #include <limits>
 #include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <algorithm>
 #include <type_traits>
 
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
 
 namespace senoval
 {
@@ -48,6 +57,15 @@ namespace senoval
  *
  *  - equal()           Perform equality comparison in a way that doesn't trigger compiler warnings.
  *                      For floats, the method is (x <= y) && (x >= y); otherwise the plain operator == is used.
+ *
+ *  - closeUlps()       Compare two floats by the number of representable values between them.
+ *                      Integer-only and constexpr; see also ulpDistance() and the Ulps<> policy for close().
+ *
+ *  - Tolerance<>       A compile-time tolerance for close<Policy>(), closeToZero<Policy>(), positive<Policy>(),
+ *                      negative<Policy>() and the batch functions, instead of the run-time epsilons.
+ *
+ *  - allClose(), firstMismatch(), closeMask()
+ *                      Apply close() element-wise to two arrays of floats, with the same semantics.
  */
 namespace comparison
 {
@@ -58,7 +76,7 @@ namespace comparison
  *  https://code.google.com/p/googletest/source/browse/trunk/include/gtest/internal/gtest-internal.h
  */
 #ifdef SENOVAL_DEFAULT_FLOAT_COMPARISON_EPSILON_MULT
-static constexpr unsigned DefaultEpsilonMultiplier = DEFAULT_FLOAT_COMPARISON_EPSILON_MULT;
+static constexpr unsigned DefaultEpsilonMultiplier = SENOVAL_DEFAULT_FLOAT_COMPARISON_EPSILON_MULT;
 #else
 static constexpr unsigned DefaultEpsilonMultiplier = 10;
 #endif
@@ -68,8 +86,8 @@ static constexpr unsigned DefaultEpsilonMultiplier = 10;
  * Most of the time you DON'T want to use this function! Consider using close() instead.
  */
 template <typename L, typename R>
-inline bool equal(const L& left,
-                  const R& right)
+constexpr bool equal(const L& left,
+                     const R& right)
 {
     if constexpr (std::is_floating_point_v<std::decay_t<L>> ||
                   std::is_floating_point_v<std::decay_t<R>>)
@@ -86,7 +104,7 @@ inline bool equal(const L& left,
  * This function performs fuzzy comparison of two floating point numbers.
  * Type of T can be either float, double or long double.
  * For details refer to http://randomascii.wordpress.com/2012/02/25/comparing-floating-point-numbers-2012-edition/
- * See also: @ref DEFAULT_FLOAT_COMPARISON_EPSILON_MULT.
+ * See also: @ref SENOVAL_DEFAULT_FLOAT_COMPARISON_EPSILON_MULT, @ref Tolerance.
  */
 template <typename T>
 inline bool close(const T a,
@@ -213,5 +231,534 @@ inline bool negative(const T& x)
     return (x < T(0)) && !closeToZero(x);
 }
 
+/*
+ * ULP-based comparison. The floats are compared as integers: the bit patterns are mapped onto an ordered integer
+ * scale where adjacent floats differ by one, and -0 and +0 coincide. No FPU operations are involved, which matters
+ * in soft-float builds, and the functions are usable in constant expressions (given the bit cast builtin).
+ * Note that near zero the ULPs are tiny, so a value that is expected to be zero is better checked with close().
+ */
+namespace detail
+{
+template <typename T> struct FloatBits;
+template <> struct FloatBits<float>  { using Type = std::uint32_t; };
+template <> struct FloatBits<double> { using Type = std::uint64_t; };
+
+template <typename T>
+using FloatBitsType = typename FloatBits<T>::Type;
+
+template <typename T>
+inline constexpr FloatBitsType<T> FloatSignMask = FloatBitsType<T>(1) << (sizeof(T) * 8U - 1U);
+
+template <typename T>
+inline constexpr FloatBitsType<T> FloatExponentMask =
+    senoval::detail::bitCast<FloatBitsType<T>>(std::numeric_limits<T>::infinity());
+
+/// Sign-magnitude to biased, so that the integer order is the float order.
+template <typename T>
+constexpr FloatBitsType<T> orderFloatBits(const FloatBitsType<T> bits)
+{
+    using U = FloatBitsType<T>;
+    const U negative = U(U(0) - (bits >> (sizeof(T) * 8U - 1U)));      // All ones if negative
+    return U(U(U(bits ^ negative) - negative) ^ U(FloatSignMask<T> & ~negative));
+}
+
+template <typename T>
+constexpr FloatBitsType<T> getOrderedDistance(const FloatBitsType<T> a, const FloatBitsType<T> b)
+{
+    const auto oa = orderFloatBits<T>(a);
+    const auto ob = orderFloatBits<T>(b);
+    return (oa >= ob) ? FloatBitsType<T>(oa - ob) : FloatBitsType<T>(ob - oa);
+}
+
+}
+
+/**
+ * The number of representable values between the arguments; zero if they are equal, including -0 vs. +0.
+ * If either argument is NaN, the maximum is returned. Infinity is one ULP away from the largest finite value.
+ * Type of T can be either float or double.
+ */
+template <typename T>
+constexpr detail::FloatBitsType<T> ulpDistance(const T a, const T b)
+{
+    using U = detail::FloatBitsType<T>;
+    const U bits_a = senoval::detail::bitCast<U>(a);
+    const U bits_b = senoval::detail::bitCast<U>(b);
+    const bool nan = (U(bits_a & ~detail::FloatSignMask<T>) > detail::FloatExponentMask<T>) ||
+                     (U(bits_b & ~detail::FloatSignMask<T>) > detail::FloatExponentMask<T>);
+    return nan ? std::numeric_limits<U>::max() : detail::getOrderedDistance<T>(bits_a, bits_b);
+}
+
+/**
+ * True if the arguments are at most MaxUlps apart. The special values are treated like in close():
+ * NaN is not close to anything, and infinity is close only to the same infinity.
+ */
+template <unsigned MaxUlps, typename T>
+constexpr bool closeUlps(const T a, const T b)
+{
+    using U = detail::FloatBitsType<T>;
+    const U bits_a = senoval::detail::bitCast<U>(a);
+    const U bits_b = senoval::detail::bitCast<U>(b);
+    const bool finite = (U(bits_a & ~detail::FloatSignMask<T>) < detail::FloatExponentMask<T>) &&
+                        (U(bits_b & ~detail::FloatSignMask<T>) < detail::FloatExponentMask<T>);
+    const bool nan = (U(bits_a & ~detail::FloatSignMask<T>) > detail::FloatExponentMask<T>) ||
+                     (U(bits_b & ~detail::FloatSignMask<T>) > detail::FloatExponentMask<T>);
+    return finite ? (detail::getOrderedDistance<T>(bits_a, bits_b) <= MaxUlps) : (!nan && (bits_a == bits_b));
+}
+
+/**
+ * A compile-time comparison tolerance. The epsilons are multiples of the machine epsilon of the compared type,
+ * so one policy works for float and double alike. Two values are close if they are close according to close()
+ * with these epsilons, or if they are at most MaxUlps apart (ULP comparison is not used if MaxUlps is zero).
+ * If both multipliers are zero, only the integer-only ULP comparison is performed; Ulps<0> is exact equality.
+ *
+ *      using Loose = Tolerance<100, 1000>;
+ *      if (close<Loose>(a, b)) { ... }
+ *
+ * Any type that provides the same three members can be used as a policy,
+ * e.g. to specify an epsilon that is not a multiple of the machine epsilon.
+ */
+template <unsigned AbsoluteEpsilonMult, unsigned RelativeEpsilonMult, unsigned MaxUlps_ = 0>
+struct Tolerance
+{
+    static constexpr unsigned MaxUlps = MaxUlps_;
+
+    template <typename T>
+    static constexpr T getAbsoluteEpsilon() { return std::numeric_limits<T>::epsilon() * T(AbsoluteEpsilonMult); }
+
+    template <typename T>
+    static constexpr T getRelativeEpsilon() { return std::numeric_limits<T>::epsilon() * T(RelativeEpsilonMult); }
+};
+
+/// The tolerance used by the overloads of close() that do not accept explicit epsilons.
+using DefaultTolerance = Tolerance<1, DefaultEpsilonMultiplier>;
+
+/// The ULP-based comparison alone: close<Ulps<4>>(a, b).
+template <unsigned MaxUlps>
+using Ulps = Tolerance<0, 0, MaxUlps>;
+
+namespace detail
+{
+template <typename Policy, typename = void>
+struct IsTolerance : std::false_type {};
+
+template <typename Policy>
+struct IsTolerance<Policy, std::void_t<decltype(Policy::MaxUlps),
+                                       decltype(Policy::template getAbsoluteEpsilon<float>()),
+                                       decltype(Policy::template getRelativeEpsilon<float>())>> : std::true_type {};
+
+template <typename Policy, typename T>
+inline constexpr bool UsesEpsilons = (Policy::template getAbsoluteEpsilon<T>() > T(0)) ||
+                                     (Policy::template getRelativeEpsilon<T>() > T(0));
+
+template <typename Policy, typename T>
+inline constexpr bool UsesUlps = (Policy::MaxUlps > 0) || !UsesEpsilons<Policy, T>;
+
+template <typename Policy, typename T>
+constexpr bool closeWithPolicy(const T a, const T b)
+{
+    bool result = false;
+    if constexpr (UsesUlps<Policy, T>)
+    {
+        static_assert(!std::is_same_v<T, long double>, "ULP comparison is not available for long double");
+        result = closeUlps<Policy::MaxUlps>(a, b);
+    }
+    if constexpr (UsesEpsilons<Policy, T>)
+    {
+        result = result ||
+                 close(a, b, Policy::template getAbsoluteEpsilon<T>(), Policy::template getRelativeEpsilon<T>());
+    }
+    return result;
+}
+
+}
+
+/**
+ * Comparison with a compile-time tolerance: close<Tolerance<1, 100>>(a, b).
+ * Mixed float types are coerced to the smaller type, like in the overloads above;
+ * if either argument is not a float, the comparison is exact.
+ * If the policy uses only ULPs, the function can be used in constant expressions.
+ */
+template <typename Policy, typename L, typename R, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+constexpr bool close(const L& left, const R& right)
+{
+    if constexpr (std::is_floating_point_v<L> && std::is_floating_point_v<R>)
+    {
+        using T = std::conditional_t<(sizeof(L) <= sizeof(R)), L, R>;
+        return detail::closeWithPolicy<Policy>(static_cast<T>(left), static_cast<T>(right));
+    }
+    else
+    {
+        return equal(left, right);
+    }
+}
+
+/// Same as close<Policy>(), the policy is given as a tag: close(a, b, Ulps<4>()).
+template <typename L, typename R, typename Policy, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+constexpr bool close(const L& left, const R& right, Policy)
+{
+    return close<Policy>(left, right);
+}
+
+template <typename Policy, typename T, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+constexpr bool closeToZero(const T& x)
+{
+    if constexpr (std::is_floating_point_v<std::decay_t<T>>)
+    {
+        return close<Policy>(x, T(0));
+    }
+    else
+    {
+        return x == T(0);
+    }
+}
+
+template <typename T, typename Policy, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+constexpr bool closeToZero(const T& x, Policy)
+{
+    return closeToZero<Policy>(x);
+}
+
+template <typename Policy, typename T, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+constexpr bool positive(const T& x)
+{
+    return (x > T(0)) && !closeToZero<Policy>(x);
+}
+
+template <typename Policy, typename T, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+constexpr bool negative(const T& x)
+{
+    return (x < T(0)) && !closeToZero<Policy>(x);
+}
+
+/*
+ * Batch comparison of arrays of floats; element-wise identical to close(), including the handling of NaN and Inf.
+ * The arrays are processed in blocks of 32 elements whose results are collected into a bit mask without branching.
+ * SSE2 is used explicitly for float and double; on other targets the branch-free kernel is left to
+ * the auto-vectorizer. The containers can be anything with std::data() and std::size(), e.g. Vector or Span.
+ */
+namespace detail
+{
+constexpr std::size_t BatchBlockSize = 32;
+
+/// Same result as close(): if either value is not finite (Inf, NaN), they are close only if they are equal.
+template <typename T>
+inline bool closeBranchFree(const T a,
+                            const T b,
+                            const T absolute_epsilon,
+                            const T relative_epsilon)
+{
+    const T abs_a = std::abs(a);
+    const T abs_b = std::abs(b);
+    const T diff = std::abs(a - b);
+    const bool finite = (abs_a <= std::numeric_limits<T>::max()) & (abs_b <= std::numeric_limits<T>::max());
+    const bool near = (diff <= absolute_epsilon) | (diff <= (std::max(abs_a, abs_b) * relative_epsilon));
+    return (finite & near) | (!finite & equal(a, b));
+}
+
+#if defined(__SSE2__)
+inline unsigned closeSSE2(const float* const a,
+                          const float* const b,
+                          const __m128 absolute_epsilon,
+                          const __m128 relative_epsilon)
+{
+    const __m128 sign = _mm_set1_ps(-0.0F);
+    const __m128 va = _mm_loadu_ps(a);
+    const __m128 vb = _mm_loadu_ps(b);
+    const __m128 abs_a = _mm_andnot_ps(sign, va);
+    const __m128 abs_b = _mm_andnot_ps(sign, vb);
+    const __m128 diff = _mm_andnot_ps(sign, _mm_sub_ps(va, vb));
+    const __m128 limit = _mm_set1_ps(std::numeric_limits<float>::max());
+    const __m128 finite = _mm_and_ps(_mm_cmple_ps(abs_a, limit), _mm_cmple_ps(abs_b, limit));
+    const __m128 near = _mm_or_ps(_mm_cmple_ps(diff, absolute_epsilon),
+                                  _mm_cmple_ps(diff, _mm_mul_ps(_mm_max_ps(abs_a, abs_b), relative_epsilon)));
+    const __m128 result = _mm_or_ps(_mm_and_ps(finite, near), _mm_andnot_ps(finite, _mm_cmpeq_ps(va, vb)));
+    return unsigned(_mm_movemask_ps(result));
+}
+
+inline unsigned closeSSE2(const double* const a,
+                          const double* const b,
+                          const __m128d absolute_epsilon,
+                          const __m128d relative_epsilon)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d va = _mm_loadu_pd(a);
+    const __m128d vb = _mm_loadu_pd(b);
+    const __m128d abs_a = _mm_andnot_pd(sign, va);
+    const __m128d abs_b = _mm_andnot_pd(sign, vb);
+    const __m128d diff = _mm_andnot_pd(sign, _mm_sub_pd(va, vb));
+    const __m128d limit = _mm_set1_pd(std::numeric_limits<double>::max());
+    const __m128d finite = _mm_and_pd(_mm_cmple_pd(abs_a, limit), _mm_cmple_pd(abs_b, limit));
+    const __m128d near = _mm_or_pd(_mm_cmple_pd(diff, absolute_epsilon),
+                                   _mm_cmple_pd(diff, _mm_mul_pd(_mm_max_pd(abs_a, abs_b), relative_epsilon)));
+    const __m128d result = _mm_or_pd(_mm_and_pd(finite, near), _mm_andnot_pd(finite, _mm_cmpeq_pd(va, vb)));
+    return unsigned(_mm_movemask_pd(result));
+}
+#endif
+
+/// Bit i is set if the elements at i are close; at most BatchBlockSize elements.
+template <typename T>
+inline std::uint32_t getCloseMask(const T* const a,
+                                  const T* const b,
+                                  const std::size_t size,
+                                  const T absolute_epsilon,
+                                  const T relative_epsilon)
+{
+    std::uint32_t mask = 0;
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    if constexpr (std::is_same_v<T, float>)
+    {
+        const __m128 ae = _mm_set1_ps(absolute_epsilon);
+        const __m128 re = _mm_set1_ps(relative_epsilon);
+        for (; (i + 4U) <= size; i += 4U)
+        {
+            mask |= std::uint32_t(closeSSE2(a + i, b + i, ae, re)) << i;
+        }
+    }
+    if constexpr (std::is_same_v<T, double>)
+    {
+        const __m128d ae = _mm_set1_pd(absolute_epsilon);
+        const __m128d re = _mm_set1_pd(relative_epsilon);
+        for (; (i + 2U) <= size; i += 2U)
+        {
+            mask |= std::uint32_t(closeSSE2(a + i, b + i, ae, re)) << i;
+        }
+    }
+#endif
+    for (; i < size; i++)
+    {
+        mask |= std::uint32_t(closeBranchFree(a[i], b[i], absolute_epsilon, relative_epsilon)) << i;
+    }
+    return mask;
+}
+
+/// Same as getCloseMask() with the epsilons and/or the ULP limit taken from the policy.
+template <typename Policy, typename T>
+inline std::uint32_t getCloseMask(const T* const a,
+                                  const T* const b,
+                                  const std::size_t size)
+{
+    std::uint32_t mask = 0;
+    if constexpr (UsesEpsilons<Policy, T>)
+    {
+        mask = getCloseMask(a, b, size,
+                            Policy::template getAbsoluteEpsilon<T>(),
+                            Policy::template getRelativeEpsilon<T>());
+    }
+    if constexpr (UsesUlps<Policy, T>)
+    {
+        static_assert(!std::is_same_v<T, long double>, "ULP comparison is not available for long double");
+        for (std::size_t i = 0; i < size; i++)
+        {
+            mask |= std::uint32_t(closeUlps<Policy::MaxUlps>(a[i], b[i])) << i;
+        }
+    }
+    return mask;
+}
+
+/// The mask getter is invoked as (offset, block) -> mask.
+template <typename MaskGetter>
+inline std::size_t findFirstMismatch(const std::size_t size, const MaskGetter& get_mask)
+{
+    for (std::size_t offset = 0; offset < size; offset += BatchBlockSize)
+    {
+        const std::size_t block = std::min(BatchBlockSize, size - offset);
+        const std::uint32_t mask = get_mask(offset, block);
+        if (mask != (std::uint32_t(0xFFFF'FFFFUL) >> (BatchBlockSize - block)))
+        {
+            std::size_t index = 0;
+            while (((mask >> index) & 1U) != 0)
+            {
+                index++;
+            }
+            return offset + index;
+        }
+    }
+    return size;
+}
+
+template <typename MaskGetter>
+inline std::size_t fillCloseMask(const std::size_t size, bool* const out_mask, const MaskGetter& get_mask)
+{
+    std::size_t mismatches = 0;
+    for (std::size_t offset = 0; offset < size; offset += BatchBlockSize)
+    {
+        const std::size_t block = std::min(BatchBlockSize, size - offset);
+        const std::uint32_t mask = get_mask(offset, block);
+        for (std::size_t i = 0; i < block; i++)
+        {
+            const bool close_i = ((mask >> i) & 1U) != 0;
+            out_mask[offset + i] = close_i;
+            mismatches += close_i ? 0U : 1U;
+        }
+    }
+    return mismatches;
+}
+
+template <typename Container>
+using ElementOf = std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const Container&>()))>>;
+
+}
+
+/**
+ * Returns the index of the first pair of elements that are not close; the size if all of them are.
+ * The tolerance is either given explicitly, or as a policy: firstMismatch<Tolerance<1, 100>>(a, b, size).
+ */
+template <typename T>
+inline std::size_t firstMismatch(const T* const a,
+                                 const T* const b,
+                                 const std::size_t size,
+                                 const T absolute_epsilon,
+                                 const T relative_epsilon)
+{
+    static_assert(std::is_floating_point_v<T>, "Batch comparison is defined for floats only");
+    return detail::findFirstMismatch(size, [&](const std::size_t offset, const std::size_t block)
+    {
+        return detail::getCloseMask(a + offset, b + offset, block, absolute_epsilon, relative_epsilon);
+    });
+}
+
+template <typename Policy, typename T, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+inline std::size_t firstMismatch(const T* const a,
+                                 const T* const b,
+                                 const std::size_t size)
+{
+    static_assert(std::is_floating_point_v<T>, "Batch comparison is defined for floats only");
+    return detail::findFirstMismatch(size, [&](const std::size_t offset, const std::size_t block)
+    {
+        return detail::getCloseMask<Policy>(a + offset, b + offset, block);
+    });
+}
+
+template <typename T>
+inline std::size_t firstMismatch(const T* const a,
+                                 const T* const b,
+                                 const std::size_t size)
+{
+    return firstMismatch<DefaultTolerance>(a, b, size);
+}
+
+/**
+ * If the containers are of different sizes and the shorter one matches the beginning of the longer one,
+ * the size of the shorter one is returned.
+ */
+template <typename Policy, typename A, typename B, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+inline std::size_t firstMismatch(const A& a, const B& b)
+{
+    using T = detail::ElementOf<A>;
+    static_assert(std::is_same_v<T, detail::ElementOf<B>>, "The element types shall be the same");
+    const std::size_t size = std::min(std::size_t(std::size(a)), std::size_t(std::size(b)));
+    return firstMismatch<Policy, T>(std::data(a), std::data(b), size);
+}
+
+template <typename A, typename B, typename = detail::ElementOf<A>>
+inline std::size_t firstMismatch(const A& a, const B& b)
+{
+    return firstMismatch<DefaultTolerance>(a, b);
+}
+
+/**
+ * True if all pairs of elements are close. Containers of different sizes are never close.
+ */
+template <typename T>
+inline bool allClose(const T* const a,
+                     const T* const b,
+                     const std::size_t size,
+                     const T absolute_epsilon,
+                     const T relative_epsilon)
+{
+    return firstMismatch(a, b, size, absolute_epsilon, relative_epsilon) == size;
+}
+
+template <typename Policy, typename T, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+inline bool allClose(const T* const a,
+                     const T* const b,
+                     const std::size_t size)
+{
+    return firstMismatch<Policy>(a, b, size) == size;
+}
+
+template <typename T>
+inline bool allClose(const T* const a,
+                     const T* const b,
+                     const std::size_t size)
+{
+    return allClose<DefaultTolerance>(a, b, size);
+}
+
+template <typename Policy, typename A, typename B, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+inline bool allClose(const A& a, const B& b)
+{
+    return (std::size_t(std::size(a)) == std::size_t(std::size(b))) &&
+           (firstMismatch<Policy>(a, b) == std::size_t(std::size(a)));
+}
+
+template <typename A, typename B, typename = detail::ElementOf<A>>
+inline bool allClose(const A& a, const B& b)
+{
+    return allClose<DefaultTolerance>(a, b);
+}
+
+/**
+ * Writes the result of close() for each pair of elements into the output array of the same size.
+ * Returns the number of pairs that are NOT close, so zero means that the arrays are close.
+ */
+template <typename T>
+inline std::size_t closeMask(const T* const a,
+                             const T* const b,
+                             const std::size_t size,
+                             bool* const out_mask,
+                             const T absolute_epsilon,
+                             const T relative_epsilon)
+{
+    static_assert(std::is_floating_point_v<T>, "Batch comparison is defined for floats only");
+    return detail::fillCloseMask(size, out_mask, [&](const std::size_t offset, const std::size_t block)
+    {
+        return detail::getCloseMask(a + offset, b + offset, block, absolute_epsilon, relative_epsilon);
+    });
+}
+
+template <typename Policy, typename T, typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+inline std::size_t closeMask(const T* const a,
+                             const T* const b,
+                             const std::size_t size,
+                             bool* const out_mask)
+{
+    static_assert(std::is_floating_point_v<T>, "Batch comparison is defined for floats only");
+    return detail::fillCloseMask(size, out_mask, [&](const std::size_t offset, const std::size_t block)
+    {
+        return detail::getCloseMask<Policy>(a + offset, b + offset, block);
+    });
+}
+
+template <typename T>
+inline std::size_t closeMask(const T* const a,
+                             const T* const b,
+                             const std::size_t size,
+                             bool* const out_mask)
+{
+    return closeMask<DefaultTolerance>(a, b, size, out_mask);
+}
+
+/// The output container shall be at least as large as the inputs, which shall be of the same size.
+template <typename Policy, typename A, typename B, typename Out,
+          typename = std::enable_if_t<detail::IsTolerance<Policy>::value>>
+inline std::size_t closeMask(const A& a, const B& b, Out& out_mask)
+{
+    using T = detail::ElementOf<A>;
+    static_assert(std::is_same_v<T, detail::ElementOf<B>>, "The element types shall be the same");
+    assert(std::size_t(std::size(a)) == std::size_t(std::size(b)));
+    const std::size_t size = std::min(std::size_t(std::size(a)), std::size_t(std::size(b)));
+    assert(std::size_t(std::size(out_mask)) >= size);
+    return closeMask<Policy, T>(std::data(a), std::data(b), std::min(size, std::size_t(std::size(out_mask))),
+                                std::data(out_mask));
+}
+
+template <typename A, typename B, typename Out, typename = detail::ElementOf<A>>
+inline std::size_t closeMask(const A& a, const B& b, Out& out_mask)
+{
+    return closeMask<DefaultTolerance>(a, b, out_mask);
+}
+
 }
 }
@@ -0,0 +1,420 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+
+namespace senoval
+{
+namespace detail
+{
+/**
+ * lower_bound() without data-dependent branches: the range is halved on every step by a conditional move,
+ * so the loop runs exactly log2(n) times and there are no mispredictions.
+ * For large arrays, both possible next midpoints are prefetched while the current comparison is in flight.
+ */
+template <bool Prefetch, typename T, typename Q, typename Projection, typename Compare>
+const T* findLowerBound(const T* base, std::size_t n, const Q& key, const Projection& projection, Compare compare)
+{
+    if (n == 0)
+    {
+        return base;
+    }
+    while (n > 1)
+    {
+        const std::size_t half = n / 2U;
+#if defined(__GNUC__)
+        if constexpr (Prefetch)
+        {
+            __builtin_prefetch(base + (half / 2U));
+            __builtin_prefetch(base + half + (half / 2U));
+        }
+#endif
+        base = compare(projection(base[half]), key) ? (base + half) : base;
+        n -= half;
+    }
+    return base + (compare(projection(*base), key) ? 1 : 0);
+}
+
+/// Prefetching pays off only when the array does not fit into the L1 cache.
+template <typename T, std::size_t Capacity>
+inline constexpr bool ShouldPrefetch = (sizeof(T) * Capacity) > 4096U;
+
+struct Identity
+{
+    template <typename T>
+    constexpr const T& operator()(const T& x) const { return x; }
+};
+
+/**
+ * Fills the vector with the elements of the range sorted by the key, keeping one element per key.
+ * The duplicates are dropped whenever the vector fills up, so they never displace a distinct key that comes later;
+ * once the distinct keys alone fill the vector, the rest of the range is only looked up.
+ * Returns false if some distinct keys did not fit; those are the last ones in the order of the range.
+ */
+template <typename Projection, typename Compare, typename Items, typename InputIterator>
+bool buildSortedUnique(Items& items, InputIterator first, const InputIterator last)
+{
+    using T = std::remove_reference_t<decltype(*items.begin())>;
+    const auto less = [](const T& a, const T& b) { return Compare()(Projection()(a), Projection()(b)); };
+    const auto same = [](const T& a, const T& b) { return !Compare()(Projection()(a), Projection()(b)); };
+    std::size_t sorted = 0;         // The leading elements are sorted and unique
+    const auto inSorted = [&items, &sorted](const auto& key)
+    {
+        const T* const it = findLowerBound<false>(items.begin(), sorted, key, Projection(), Compare());
+        return (it != (items.begin() + sorted)) && !Compare()(key, Projection()(*it));
+    };
+    const auto compact = [&items, &sorted, &less, &same]()
+    {
+        std::sort(items.begin(), items.end(), less);
+        (void) items.erase(std::unique(items.begin(), items.end(), same), items.end());
+        sorted = items.size();
+    };
+
+    bool fit = true;
+    items.clear();
+    for (; first != last; ++first)
+    {
+        const T& value = *first;
+        if (inSorted(Projection()(value)))
+        {
+            continue;
+        }
+        if (items.size() >= items.capacity())
+        {
+            if (sorted < items.size())
+            {
+                compact();
+            }
+            if (inSorted(Projection()(value)))
+            {
+                continue;
+            }
+            if (items.size() >= items.capacity())
+            {
+                fit = false;
+                continue;
+            }
+        }
+        items.push_back(value);
+    }
+    compact();
+    return fit;
+}
+
+}
+
+/**
+ * A sorted associative container stored in a Vector<>, for data that is set up once and looked up often.
+ * Compared to Map<>, it has no overhead per entry, is cache-friendly, and iterates in the key order;
+ * insertion and erasure are O(n), but for trivially copyable entries they are a single memmove().
+ *
+ * The comparator shall be default-constructible; the default one is transparent, so a map keyed by String<>
+ * can be queried by const char* or StringView. The entries are immutable through the iterators;
+ * use get() to modify a value in place.
+ */
+template <typename K, typename V, std::size_t Capacity_, typename Compare = std::less<>>
+class FlatMap
+{
+public:
+    static constexpr std::size_t Capacity = Capacity_;
+
+    struct Entry
+    {
+        K key;
+        V value;
+    };
+
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = Entry;
+    using size_type = std::size_t;
+    using iterator = const Entry*;
+    using const_iterator = const Entry*;
+
+private:
+    Vector<Entry, Capacity> items_;
+
+    struct KeyOf
+    {
+        constexpr const K& operator()(const Entry& e) const { return e.key; }
+    };
+
+    template <typename Q>
+    [[nodiscard]]
+    bool matches(const const_iterator it, const Q& key) const
+    {
+        return (it != end()) && !Compare()(key, it->key);
+    }
+
+public:
+    FlatMap() = default;
+
+    FlatMap(std::initializer_list<Entry> entries)   // NOLINT implicit by design
+    {
+        buildFromUnsorted(entries.begin(), entries.end());
+    }
+
+    /**
+     * Replaces the contents with the range and sorts it, which is faster than inserting one by one.
+     * If a key is repeated, which one of its entries is kept is unspecified; the duplicates do not take up room,
+     * so the entries are discarded only if there are more distinct keys than the capacity, in which case
+     * the result is false.
+     */
+    template <typename InputIterator>
+    bool buildFromUnsorted(const InputIterator first, const InputIterator last)
+    {
+        return detail::buildSortedUnique<KeyOf, Compare>(items_, first, last);
+    }
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
+    [[nodiscard]] constexpr std::size_t max_size() const { return Capacity; }
+
+    [[nodiscard]] std::size_t size() const { return items_.size(); }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return items_.empty(); }
+
+    void clear() { items_.clear(); }
+
+    [[nodiscard]] const_iterator begin() const { return items_.begin(); }
+    [[nodiscard]] const_iterator end()   const { return items_.end(); }
+
+    /// The first entry whose key is not less than the argument.
+    template <typename Q>
+    [[nodiscard]]
+    const_iterator lower_bound(const Q& key) const
+    {
+        return detail::findLowerBound<detail::ShouldPrefetch<Entry, Capacity>>(items_.data(), items_.size(), key,
+                                                                                KeyOf(), Compare());
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    const_iterator find(const Q& key) const
+    {
+        const const_iterator it = lower_bound(key);
+        return matches(it, key) ? it : end();
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    bool contains(const Q& key) const { return find(key) != end(); }
+
+    template <typename Q>
+    [[nodiscard]]
+    std::size_t count(const Q& key) const { return contains(key) ? 1U : 0U; }
+
+    /// Pointer to the value or nullptr if there is no such key.
+    template <typename Q>
+    [[nodiscard]]
+    V* get(const Q& key)
+    {
+        const const_iterator it = find(key);
+        return (it == end()) ? nullptr : &items_[std::size_t(it - begin())].value;
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    const V* get(const Q& key) const
+    {
+        return const_cast<FlatMap*>(this)->get(key);
+    }
+
+    /// If the map is full and the key is not there, returns (end(), false).
+    template <typename Q, typename... Args>
+    std::pair<const_iterator, bool> try_emplace(const Q& key, Args&&... args)
+    {
+        const const_iterator it = lower_bound(key);
+        if (matches(it, key))
+        {
+            return {it, false};
+        }
+        if (size() >= Capacity)
+        {
+            return {end(), false};
+        }
+        return {items_.emplace(it, Entry{K(key), V(std::forward<Args>(args)...)}), true};
+    }
+
+    template <typename Q, typename T>
+    std::pair<const_iterator, bool> insert_or_assign(const Q& key, T&& value)
+    {
+        const auto out = try_emplace(key, std::forward<T>(value));
+        if (!out.second && (out.first != end()))
+        {
+            *get(key) = std::forward<T>(value);
+        }
+        return out;
+    }
+
+    std::pair<const_iterator, bool> insert(const Entry& entry)
+    {
+        return try_emplace(entry.key, entry.value);
+    }
+
+    const_iterator erase(const const_iterator position)
+    {
+        return items_.erase(position);
+    }
+
+    /// Returns the number of erased entries, zero or one.
+    template <typename Q>
+    std::size_t erase(const Q& key)
+    {
+        const const_iterator it = find(key);
+        if (it == end())
+        {
+            return 0;
+        }
+        (void) items_.erase(it);
+        return 1;
+    }
+};
+
+/**
+ * A sorted set stored in a Vector<>; see FlatMap<>.
+ */
+template <typename T, std::size_t Capacity_, typename Compare = std::less<>>
+class FlatSet
+{
+public:
+    static constexpr std::size_t Capacity = Capacity_;
+
+    using key_type = T;
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = const T*;
+    using const_iterator = const T*;
+
+private:
+    Vector<T, Capacity> items_;
+
+    template <typename Q>
+    [[nodiscard]]
+    bool matches(const const_iterator it, const Q& key) const
+    {
+        return (it != end()) && !Compare()(key, *it);
+    }
+
+public:
+    FlatSet() = default;
+
+    FlatSet(std::initializer_list<T> values)    // NOLINT implicit by design
+    {
+        buildFromUnsorted(values.begin(), values.end());
+    }
+
+    /// Replaces the contents with the range and sorts it. The duplicates are dropped before anything is discarded
+    /// for the lack of room; the result is false if there are more distinct elements than the capacity.
+    template <typename InputIterator>
+    bool buildFromUnsorted(const InputIterator first, const InputIterator last)
+    {
+        return detail::buildSortedUnique<detail::Identity, Compare>(items_, first, last);
+    }
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
+    [[nodiscard]] constexpr std::size_t max_size() const { return Capacity; }
+
+    [[nodiscard]] std::size_t size() const { return items_.size(); }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return items_.empty(); }
+
+    void clear() { items_.clear(); }
+
+    [[nodiscard]] const_iterator begin() const { return items_.begin(); }
+    [[nodiscard]] const_iterator end()   const { return items_.end(); }
+
+    template <typename Q>
+    [[nodiscard]]
+    const_iterator lower_bound(const Q& key) const
+    {
+        return detail::findLowerBound<detail::ShouldPrefetch<T, Capacity>>(items_.data(), items_.size(), key,
+                                                                            detail::Identity(), Compare());
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    const_iterator find(const Q& key) const
+    {
+        const const_iterator it = lower_bound(key);
+        return matches(it, key) ? it : end();
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    bool contains(const Q& key) const { return find(key) != end(); }
+
+    template <typename Q>
+    [[nodiscard]]
+    std::size_t count(const Q& key) const { return contains(key) ? 1U : 0U; }
+
+    /// If the set is full and the value is not there, returns (end(), false).
+    std::pair<const_iterator, bool> insert(const T& value)
+    {
+        const const_iterator it = lower_bound(value);
+        if (matches(it, value))
+        {
+            return {it, false};
+        }
+        if (size() >= Capacity)
+        {
+            return {end(), false};
+        }
+        return {items_.insert(it, value), true};
+    }
+
+    const_iterator erase(const const_iterator position)
+    {
+        return items_.erase(position);
+    }
+
+    template <typename Q>
+    std::size_t erase(const Q& key)
+    {
+        const const_iterator it = find(key);
+        if (it == end())
+        {
+            return 0;
+        }
+        (void) items_.erase(it);
+        return 1;
+    }
+};
+
+}
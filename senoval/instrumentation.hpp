@@ -0,0 +1,196 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <cstddef>
+
+/**
+ * Set this macro to 1 before including the library to let String<> and Vector<> record their peak size and the
+ * number of overflow events, per instance and per type. It is meant for right-sizing the capacities from the data
+ * collected in the field. By default, it is 0, and the instrumentation takes neither space nor time.
+ * All translation units of the application shall be built with the same setting.
+ */
+#ifndef SENOVAL_INSTRUMENTATION
+# define SENOVAL_INSTRUMENTATION 0
+#endif
+
+
+namespace senoval
+{
+namespace instrumentation
+{
+/// The usage statistics of a container instance or of all instances of a container type.
+struct Statistics
+{
+    std::size_t peak_size      = 0;     ///< The largest size() observed
+    std::size_t overflow_count = 0;     ///< The number of events reported to the overflow policy
+};
+
+/**
+ * The aggregate statistics of all instances of a container type. Records are created on the first update
+ * and form a global list, which can be traversed to dump the data:
+ *
+ *      for (auto r = instrumentation::Record::getFirst(); r != nullptr; r = r->getNext())
+ *      {
+ *          log(r->getSignature(), r->getCapacity(), r->getStatistics().peak_size);
+ *      }
+ *
+ * The registry is not thread-safe; a concurrent update may be lost, which is acceptable for diagnostics.
+ * The instances that are only used in constant expressions are not registered.
+ */
+class Record
+{
+    static inline Record* first_ = nullptr;
+
+    const char* const signature_;
+    const std::size_t capacity_;
+    const std::size_t footprint_;
+    Statistics statistics_;
+    Record* const next_;
+
+public:
+    Record(const char* const signature, const std::size_t capacity, const std::size_t footprint) :
+        signature_(signature),
+        capacity_(capacity),
+        footprint_(footprint),
+        next_(first_)
+    {
+        first_ = this;
+    }
+
+    Record(const Record&) = delete;
+    Record& operator=(const Record&) = delete;
+
+    /// The most recently created record; nullptr if there are none.
+    [[nodiscard]] static const Record* getFirst() { return first_; }
+
+    [[nodiscard]] const Record* getNext() const { return next_; }
+
+    /// A compiler-specific description of the container type, e.g., the pretty function name. May be null.
+    [[nodiscard]] const char* getSignature() const { return signature_; }
+
+    [[nodiscard]] std::size_t getCapacity() const { return capacity_; }
+
+    /// sizeof() of the container type, in bytes; the RAM cost of one instance.
+    [[nodiscard]] std::size_t getFootprint() const { return footprint_; }
+
+    [[nodiscard]] const Statistics& getStatistics() const { return statistics_; }
+
+    void resetStatistics() { statistics_ = Statistics(); }
+
+    void noteSize(const std::size_t size)
+    {
+        if (size > statistics_.peak_size)
+        {
+            statistics_.peak_size = size;
+        }
+    }
+
+    void noteOverflow() { ++statistics_.overflow_count; }
+};
+
+/// The record of the specified container type; e.g., getRecord<String<64>>().
+template <typename Container>
+inline Record& getRecord()
+{
+#if defined(__GNUC__)
+    static Record record(__PRETTY_FUNCTION__, Container::Capacity, sizeof(Container));
+#else
+    static Record record(nullptr, Container::Capacity, sizeof(Container));
+#endif
+    return record;
+}
+
+}
+
+namespace detail
+{
+/**
+ * The base class of the instrumented containers, with CRTP. The container reports each growth and each overflow event.
+ * Modifications made through StringRef or VectorRef<> are not observed.
+ * In the default build, all members are no-ops, and the base class takes no space.
+ */
+template <typename Container>
+class Instrumented
+{
+#if SENOVAL_INSTRUMENTATION
+    // Not mutable, so that the containers can still be copied in constant expressions.
+    instrumentation::Statistics statistics_;
+
+protected:
+    constexpr void noteSize(const std::size_t size)
+    {
+        if (size > statistics_.peak_size)
+        {
+            statistics_.peak_size = size;
+        }
+        // The registry is only updated at run time; also if the compiler can't tell, see isConstantEvaluated().
+        if (!isConstantEvaluated())
+        {
+            instrumentation::getRecord<Container>().noteSize(size);
+        }
+    }
+
+    constexpr void noteOverflow()
+    {
+        ++statistics_.overflow_count;
+        static_cast<const Instrumented*>(this)->noteOverflow();
+    }
+
+    /// An event in a const member function, e.g., operator[] const, is counted only in the record of the type.
+    constexpr void noteOverflow() const
+    {
+        if (!isConstantEvaluated())
+        {
+            instrumentation::getRecord<Container>().noteOverflow();
+        }
+    }
+
+public:
+    /// The statistics are copied along with the contents of the container.
+    [[nodiscard]] constexpr const instrumentation::Statistics& getStatistics() const { return statistics_; }
+
+    constexpr void resetStatistics() { statistics_ = instrumentation::Statistics(); }
+#else
+protected:
+    constexpr void noteSize(const std::size_t) { }
+    constexpr void noteOverflow() const { }
+
+public:
+    /// Always zero unless SENOVAL_INSTRUMENTATION is set.
+    [[nodiscard]] constexpr instrumentation::Statistics getStatistics() const { return {}; }
+
+    constexpr void resetStatistics() { }
+#endif
+};
+
+}
+}
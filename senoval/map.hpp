@@ -0,0 +1,483 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include "string_view.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace senoval
+{
+namespace detail
+{
+/**
+ * Everything convertible to StringView (String<>, const char*, std::string, ...) is hashed and compared
+ * as a sequence of chars, which makes lookups by different string types interchangeable.
+ */
+template <typename T>
+inline constexpr bool IsStringLike = std::is_convertible_v<const T&, StringView> ||
+                                     std::is_convertible_v<const T&, std::string_view>;
+
+template <typename T>
+constexpr StringView toStringView(const T& s)
+{
+    if constexpr (std::is_convertible_v<const T&, StringView>)
+    {
+        return s;
+    }
+    else
+    {
+        return std::string_view(s);
+    }
+}
+
+template <typename T>
+constexpr std::uint32_t computeKeyHash(const T& key)
+{
+    if constexpr (IsStringLike<T>)
+    {
+        return toStringView(key).hash();
+    }
+    else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+    {
+        return mixBits(std::uint64_t(key));
+    }
+    else
+    {
+        return mixBits(std::uint64_t(std::hash<T>()(key)));
+    }
+}
+
+template <typename A, typename B>
+constexpr bool compareKeys(const A& a, const B& b)
+{
+    if constexpr (IsStringLike<A> && IsStringLike<B>)
+    {
+        return toStringView(a) == toStringView(b);
+    }
+    else
+    {
+        return a == b;
+    }
+}
+
+constexpr std::size_t getNextPowerOfTwo(const std::size_t x)
+{
+    std::size_t out = 1;
+    while (out < x)
+    {
+        out *= 2U;
+    }
+    return out;
+}
+
+}
+
+/**
+ * A fixed-capacity hash map, API like std::unordered_map<>. Never allocates; the table is stored inline.
+ *
+ * Open addressing with linear probing and Robin Hood ordering: each slot has a metadata field holding
+ * the distance from the home slot plus one (zero means empty); it is a byte unless the capacity exceeds 254.
+ * Entries of a cluster are kept sorted by their home slot, so a lookup stops as soon as it meets an entry
+ * that is closer to its home than the key would be, and erasure shifts the rest of the cluster back instead
+ * of leaving tombstones.
+ * The table has a power-of-two number of slots and the load factor is kept below 0.8.
+ *
+ * Strings are hashed with StringView::hash(), so a map keyed by String<> can be queried by const char*,
+ * StringView, or a String<> of a different capacity without copying the key.
+ * The entries are std::pair<const K, V>, like in std::unordered_map<>. Insertion and erasure may relocate
+ * other entries, which invalidates all iterators and references.
+ */
+template <typename K, typename V, std::size_t Capacity_>
+class Map
+{
+public:
+    static constexpr std::size_t Capacity = Capacity_;
+
+    static_assert(Capacity > 0, "Capacity must be positive");
+
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<const K, V>;
+    using size_type = std::size_t;
+
+private:
+    static constexpr std::size_t Slots = detail::getNextPowerOfTwo(Capacity + (Capacity / 4U) + 1U);
+    static constexpr std::size_t Mask = Slots - 1U;
+
+    /// A key cannot be farther from home than the number of entries, and a lookup is one step beyond that,
+    /// so the distance cannot overflow whatever the hashes are.
+    using Distance = detail::SmallestUnsignedFor<Capacity + 1U>;
+    static constexpr std::size_t MaxDistance = Capacity + 1U;
+
+    alignas(value_type) unsigned char raw_[sizeof(value_type) * Slots];
+    Distance distances_[Slots]{};
+    detail::SmallestUnsignedFor<Capacity> size_ = 0;
+
+    [[nodiscard]] value_type* getSlot(const std::size_t index)
+    {
+        return std::launder(reinterpret_cast<value_type*>(&raw_[0])) + index;
+    }
+    [[nodiscard]] const value_type* getSlot(const std::size_t index) const
+    {
+        return std::launder(reinterpret_cast<const value_type*>(&raw_[0])) + index;
+    }
+
+    struct Location
+    {
+        std::size_t index = 0;
+        Distance distance = 0;      ///< Of the key from its home slot, plus one
+        bool found = false;
+    };
+
+    template <bool IsConst>
+    class IteratorImpl
+    {
+        friend class Map;
+        friend class IteratorImpl<!IsConst>;
+        using Owner = std::conditional_t<IsConst, const Map, Map>;
+
+        Owner* owner_ = nullptr;
+        std::size_t index_ = 0;
+
+        IteratorImpl(Owner* const owner, const std::size_t index) :
+            owner_(owner),
+            index_(index)
+        {
+            skipEmpty();
+        }
+
+        void skipEmpty()
+        {
+            while ((index_ < Slots) && (owner_->distances_[index_] == 0))
+            {
+                ++index_;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::conditional_t<IsConst, const typename Map::value_type, typename Map::value_type>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = value_type*;
+        using reference = value_type&;
+
+        IteratorImpl() = default;
+
+        template <bool C = IsConst, typename = std::enable_if_t<!C>>
+        operator IteratorImpl<true>() const { return IteratorImpl<true>(owner_, index_); }   // NOLINT
+
+        [[nodiscard]] reference operator*()  const { return *owner_->getSlot(index_); }
+        [[nodiscard]] pointer   operator->() const { return owner_->getSlot(index_); }
+
+        IteratorImpl& operator++()
+        {
+            ++index_;
+            skipEmpty();
+            return *this;
+        }
+
+        IteratorImpl operator++(int)
+        {
+            const IteratorImpl tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        [[nodiscard]]
+        bool operator==(const IteratorImpl& other) const
+        {
+            return (owner_ == other.owner_) && (index_ == other.index_);
+        }
+
+        [[nodiscard]]
+        bool operator!=(const IteratorImpl& other) const { return !operator==(other); }
+    };
+
+public:
+    using iterator = IteratorImpl<false>;
+    using const_iterator = IteratorImpl<true>;
+
+    Map() { }   // NOLINT the storage is not initialized on purpose
+
+    Map(std::initializer_list<std::pair<K, V>> values)
+    {
+        for (const auto& x : values)
+        {
+            const bool inserted = try_emplace(x.first, x.second).second;
+            assert(inserted);
+            (void) inserted;
+        }
+    }
+
+    Map(const Map& other) { copyFrom(other); }
+
+    Map(Map&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+    {
+        copyFrom(std::move(other));
+        other.clear();
+    }
+
+    Map& operator=(const Map& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    Map& operator=(Map&& other) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+    {
+        if (this != &other)
+        {
+            clear();
+            copyFrom(std::move(other));
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~Map() { clear(); }
+
+    /*
+     * std::unordered_map API
+     */
+    [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
+    [[nodiscard]] constexpr std::size_t max_size() const { return Capacity; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return size_ == 0; }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < Slots; i++)
+        {
+            if (distances_[i] != 0)
+            {
+                std::destroy_at(getSlot(i));
+                distances_[i] = 0;
+            }
+        }
+        size_ = 0;
+    }
+
+    [[nodiscard]] iterator begin() { return iterator(this, 0); }
+    [[nodiscard]] iterator end()   { return iterator(this, Slots); }
+
+    [[nodiscard]] const_iterator begin() const { return const_iterator(this, 0); }
+    [[nodiscard]] const_iterator end()   const { return const_iterator(this, Slots); }
+
+    /// The key can be of any type that is comparable with K and hashes the same way, e.g., const char* for String<>.
+    template <typename Q>
+    [[nodiscard]]
+    iterator find(const Q& key)
+    {
+        const Location loc = locate(key);
+        return loc.found ? iterator(this, loc.index) : end();
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    const_iterator find(const Q& key) const
+    {
+        return const_cast<Map*>(this)->find(key);
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    bool contains(const Q& key) const
+    {
+        return locate(key).found;
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    std::size_t count(const Q& key) const
+    {
+        return contains(key) ? 1U : 0U;
+    }
+
+    /**
+     * If the key is not in the map, inserts it with the value constructed from the arguments.
+     * The key is converted to K only if it is inserted. If the map is full, returns (end(), false).
+     */
+    template <typename Q, typename... Args>
+    std::pair<iterator, bool> try_emplace(const Q& key, Args&&... args)
+    {
+        const Location loc = locate(key);
+        if (loc.found)
+        {
+            return {iterator(this, loc.index), false};
+        }
+        if (size_ >= Capacity)
+        {
+            return {end(), false};
+        }
+        // Make room by shifting the rest of the cluster forward; there is always an empty slot.
+        std::size_t last = loc.index;
+        while (distances_[last] != 0)
+        {
+            last = (last + 1U) & Mask;
+        }
+        while (last != loc.index)
+        {
+            const std::size_t prev = (last - 1U) & Mask;
+            assert(distances_[prev] < MaxDistance);
+            ::new (static_cast<void*>(getSlot(last))) value_type(std::move(*getSlot(prev)));
+            std::destroy_at(getSlot(prev));
+            distances_[last] = Distance(distances_[prev] + 1U);
+            last = prev;
+        }
+        ::new (static_cast<void*>(getSlot(loc.index))) value_type(std::piecewise_construct,
+                                                                 std::forward_as_tuple(key),
+                                                                 std::forward_as_tuple(std::forward<Args>(args)...));
+        distances_[loc.index] = loc.distance;
+        ++size_;
+        return {iterator(this, loc.index), true};
+    }
+
+    template <typename Q, typename T>
+    std::pair<iterator, bool> insert_or_assign(const Q& key, T&& value)
+    {
+        auto out = try_emplace(key, std::forward<T>(value));
+        if (!out.second && (out.first != end()))
+        {
+            out.first->second = std::forward<T>(value);
+        }
+        return out;
+    }
+
+    std::pair<iterator, bool> insert(const std::pair<K, V>& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    /// Returns the number of erased entries, zero or one.
+    template <typename Q>
+    std::size_t erase(const Q& key)
+    {
+        const Location loc = locate(key);
+        if (!loc.found)
+        {
+            return 0;
+        }
+        // Shift the rest of the cluster back until an empty slot or an entry in its home slot is met.
+        std::size_t hole = loc.index;
+        std::destroy_at(getSlot(hole));
+        for (std::size_t next = (hole + 1U) & Mask; distances_[next] > 1U; next = (next + 1U) & Mask)
+        {
+            ::new (static_cast<void*>(getSlot(hole))) value_type(std::move(*getSlot(next)));
+            std::destroy_at(getSlot(next));
+            distances_[hole] = Distance(distances_[next] - 1U);
+            hole = next;
+        }
+        distances_[hole] = 0;
+        --size_;
+        return 1;
+    }
+
+    /*
+     * Non-standard extensions.
+     */
+    /// Pointer to the value or nullptr if there is no such key.
+    template <typename Q>
+    [[nodiscard]]
+    V* get(const Q& key)
+    {
+        const Location loc = locate(key);
+        return loc.found ? &getSlot(loc.index)->second : nullptr;
+    }
+
+    template <typename Q>
+    [[nodiscard]]
+    const V* get(const Q& key) const
+    {
+        return const_cast<Map*>(this)->get(key);
+    }
+
+private:
+    /// Returns the slot that contains the key, or the slot where it would be inserted.
+    template <typename Q>
+    [[nodiscard]]
+    Location locate(const Q& key) const
+    {
+        std::size_t index = detail::computeKeyHash(key) & Mask;
+        std::size_t distance = 1;
+        while (distances_[index] >= distance)
+        {
+            if ((distances_[index] == distance) && detail::compareKeys(getSlot(index)->first, key))
+            {
+                return {index, Distance(distance), true};
+            }
+            index = (index + 1U) & Mask;
+            ++distance;
+        }
+        assert(distance <= MaxDistance);
+        return {index, Distance(distance), false};
+    }
+
+    template <typename Source>
+    void copyFrom(Source&& other)
+    {
+        for (std::size_t i = 0; i < Slots; i++)
+        {
+            if (other.distances_[i] != 0)
+            {
+                if constexpr (std::is_lvalue_reference_v<Source>)
+                {
+                    ::new (static_cast<void*>(getSlot(i))) value_type(*other.getSlot(i));
+                }
+                else
+                {
+                    ::new (static_cast<void*>(getSlot(i))) value_type(std::move(*other.getSlot(i)));
+                }
+                distances_[i] = other.distances_[i];
+            }
+        }
+        size_ = other.size_;
+    }
+};
+
+}
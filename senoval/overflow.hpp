@@ -0,0 +1,126 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace senoval
+{
+/// What went wrong; reported to the overflow policy of String<> and Vector<>.
+enum class OverflowKind : std::uint8_t
+{
+    Capacity,       ///< An element did not fit, e.g., push_back() when full; the operation was not performed
+    Truncation,     ///< A bulk operation, e.g., append() or insert(), was clamped at the capacity
+    OutOfRange,     ///< Access outside of the valid range, e.g., operator[] past the end or back() when empty
+};
+
+/**
+ * Overflow policies of String<> and Vector<>, selected by the last template parameter of the container.
+ * A policy is inherited privately by the container, so a stateless policy takes no space.
+ * If IsChecked is false, the element-wise operations (push_back(), operator[], back(), etc.) are not checked at all,
+ * except for an assertion; the caller is responsible for staying within the bounds.
+ * The bulk operations always clamp at the capacity and report the truncation; that is cheap compared to the copy.
+ * The policy is invoked before the operation is carried out or skipped, and once per operation.
+ *
+ * A custom policy shall provide the same two members as the ones below.
+ */
+namespace overflow
+{
+/// Zero overhead: the bounds are only asserted. Use in validated inner loops. Truncation is silent.
+struct Unchecked
+{
+    static constexpr bool IsChecked = false;
+
+    constexpr void onOverflow(const OverflowKind kind) const
+    {
+        assert(kind == OverflowKind::Truncation);
+        (void) kind;
+    }
+};
+
+/// Assertion failure if an element does not fit or the access is out of range; the operation is ignored if
+/// assertions are disabled. The bulk operations truncate silently. The default for Vector<>.
+struct Assert
+{
+    static constexpr bool IsChecked = true;
+
+    constexpr void onOverflow(const OverflowKind kind) const
+    {
+        assert(kind == OverflowKind::Truncation);
+        (void) kind;
+    }
+};
+
+/// The excess data is dropped silently; out-of-range access is still an assertion failure. The default for String<>.
+struct Truncate
+{
+    static constexpr bool IsChecked = true;
+
+    constexpr void onOverflow(const OverflowKind kind) const
+    {
+        assert(kind != OverflowKind::OutOfRange);
+        (void) kind;
+    }
+};
+
+/// Like Truncate, but the container counts the events, e.g., for diagnostics: s.getOverflowPolicy().getCount().
+class TruncateAndCount
+{
+    mutable std::size_t count_ = 0;
+
+public:
+    static constexpr bool IsChecked = true;
+
+    constexpr void onOverflow(const OverflowKind kind) const
+    {
+        assert(kind != OverflowKind::OutOfRange);
+        (void) kind;
+        ++count_;
+    }
+
+    [[nodiscard]] constexpr std::size_t getCount() const { return count_; }
+
+    constexpr void resetCount() const { count_ = 0; }
+};
+
+/// Invokes the handler, which may log the event or halt; the operation is ignored if the handler returns.
+template <void (*Handler)(OverflowKind)>
+struct Callback
+{
+    static constexpr bool IsChecked = true;
+
+    constexpr void onOverflow(const OverflowKind kind) const { Handler(kind); }
+};
+
+}
+}
@@ -0,0 +1,173 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <utility>
+
+
+namespace senoval
+{
+/**
+ * A fixed-size block allocator for objects of type T with inline storage; allocation and deallocation are O(1).
+ *
+ * The free blocks form an intrusive singly linked list: a free block stores the index of the next one
+ * in its own storage, so there is no per-block overhead. The blocks that have never been used are not linked
+ * in advance; they are taken in order from the unused tail, so construction of the pool is O(1) and
+ * the high watermark (the largest number of blocks ever in use at once) comes for free.
+ *
+ * The pool does not track which blocks are in use, so it does not destroy the objects that are still alive
+ * when it is destroyed. It is not thread-safe; guard it with a critical section if it is shared with an ISR.
+ */
+template <typename T, std::size_t Capacity_>
+class Pool
+{
+public:
+    static constexpr std::size_t Capacity = Capacity_;
+
+    static_assert(Capacity > 0, "Capacity must be positive");
+
+private:
+    using Index = detail::SmallestUnsignedFor<Capacity>;
+    static constexpr Index Null = Index(Capacity);
+
+    union Block
+    {
+        Index next;                                     ///< While free
+        alignas(T) unsigned char storage[sizeof(T)];    ///< While in use
+    };
+
+    Block blocks_[Capacity];        // Not initialized
+    Index free_head_ = Null;
+    Index watermark_ = 0;           ///< The blocks at and past this index have never been used
+    Index used_ = 0;
+
+public:
+    using value_type = T;
+
+    Pool() = default;
+
+    // The objects are referenced by pointers, so the pool must stay where it is.
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /// Uninitialized storage for one T, or nullptr if the pool is exhausted.
+    [[nodiscard]]
+    void* allocate()
+    {
+        Index index = Null;
+        if (free_head_ != Null)
+        {
+            index = free_head_;
+            free_head_ = blocks_[index].next;
+        }
+        else if (watermark_ < Capacity)
+        {
+            index = watermark_++;
+        }
+        else
+        {
+            return nullptr;
+        }
+        ++used_;
+        return &blocks_[index].storage[0];
+    }
+
+    /// The pointer shall have been returned by allocate() of this pool; nullptr is ignored.
+    void deallocate(void* const pointer)
+    {
+        if (pointer != nullptr)
+        {
+            assert(owns(pointer));
+            assert(used_ > 0);
+            const auto index = Index(getIndex(pointer));
+            blocks_[index].next = free_head_;
+            free_head_ = index;
+            --used_;
+        }
+    }
+
+    /// Allocates and constructs an object; returns nullptr if the pool is exhausted.
+    template <typename... Args>
+    [[nodiscard]]
+    T* construct(Args&&... args)
+    {
+        void* const p = allocate();
+        return (p == nullptr) ? nullptr : ::new (p) T(std::forward<Args>(args)...);
+    }
+
+    /// Destroys and deallocates an object created by construct(); nullptr is ignored.
+    void destroy(T* const object)
+    {
+        if (object != nullptr)
+        {
+            object->~T();
+            deallocate(object);
+        }
+    }
+
+    /// True if the pointer points to a block of this pool (whether it is in use or not).
+    [[nodiscard]]
+    bool owns(const void* const pointer) const
+    {
+        const auto* const p = static_cast<const unsigned char*>(pointer);
+        const auto* const begin = reinterpret_cast<const unsigned char*>(&blocks_[0]);
+        const auto* const end = reinterpret_cast<const unsigned char*>(&blocks_[0] + Capacity);
+        return std::less_equal<>()(begin, p) && std::less<>()(p, end) &&
+               (((std::size_t(p - begin)) % sizeof(Block)) == 0);
+    }
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
+
+    /// The number of blocks currently in use.
+    [[nodiscard]] std::size_t size() const { return used_; }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return used_ == 0; }
+
+    [[nodiscard]] bool full() const { return used_ >= Capacity; }
+
+    /// The largest number of blocks that have been in use at the same time since the pool was constructed.
+    [[nodiscard]] std::size_t getHighWatermark() const { return watermark_; }
+
+private:
+    [[nodiscard]]
+    std::size_t getIndex(const void* const pointer) const
+    {
+        const auto* const p = static_cast<const unsigned char*>(pointer);
+        return std::size_t(p - reinterpret_cast<const unsigned char*>(&blocks_[0])) / sizeof(Block);
+    }
+};
+
+}
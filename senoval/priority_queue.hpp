@@ -0,0 +1,300 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+
+namespace senoval
+{
+/**
+ * A fixed-capacity priority queue, API like std::priority_queue<>: top() is the element that would come last
+ * if sorted by Compare, so the default is a max-queue; use std::greater<> for deadlines and the like.
+ *
+ * This is a d-ary heap: a larger arity makes the tree shallower at the cost of more comparisons per level;
+ * 4 is a good default. The values are stored in the heap order, so the children of a node are contiguous
+ * and with a small T they are scanned from one or two cache lines. top() is O(1), push(), pop(), update(),
+ * and erase() are O(log n). The whole state is inline; nothing is allocated.
+ *
+ * Each value is paired with the index of its slot, and a separate table maps the slots to the heap positions.
+ * push() returns a handle to the slot, which stays valid until the element is removed, however the element
+ * moves within the heap; it allows changing the priority of a queued element (e.g., rescheduling a timer)
+ * or cancelling it. Since the values are moved while sifting, T should be cheap to move.
+ * Each slot counts its removals and the handle carries the count, so a stale handle is not mistaken for
+ * the element that has reused its slot: contains() rejects it (barring the counter wrapping around).
+ * The free positions hold default-constructed values, so T shall be default-constructible.
+ */
+template <typename T, std::size_t Capacity_, typename Compare = std::less<>, std::size_t Arity = 4>
+class PriorityQueue
+{
+public:
+    static constexpr std::size_t Capacity = Capacity_;
+
+    static_assert(Capacity > 0, "Capacity must be positive");
+    static_assert(Arity >= 2, "The arity of the heap must be at least 2");
+
+private:
+    using Index = detail::SmallestUnsignedFor<Capacity>;
+
+    struct Node
+    {
+        T value{};
+        Index slot = 0;
+    };
+
+    Node heap_[Capacity]{};         ///< In the heap order; the slots of the nodes past the size are free
+    Index positions_[Capacity]{};   ///< Where each slot is in the heap
+    std::uint32_t generations_[Capacity]{};     ///< Incremented when the slot is freed to invalidate its handles
+    Index size_ = 0;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+    /// Identifies a queued element. A default-constructed handle is invalid.
+    class Handle
+    {
+        friend class PriorityQueue;
+        Index slot_ = Capacity;
+        std::uint32_t generation_ = 0;
+        constexpr Handle(const Index slot, const std::uint32_t generation) : slot_(slot), generation_(generation) { }
+    public:
+        constexpr Handle() = default;
+        /// Only tells a default-constructed handle apart; use PriorityQueue::contains() to check for staleness.
+        [[nodiscard]] constexpr bool isValid() const { return slot_ < Capacity; }
+        [[nodiscard]] constexpr bool operator==(const Handle other) const
+        {
+            return (slot_ == other.slot_) && (generation_ == other.generation_);
+        }
+        [[nodiscard]] constexpr bool operator!=(const Handle other) const { return !operator==(other); }
+    };
+
+    PriorityQueue()
+    {
+        for (std::size_t i = 0; i < Capacity; i++)
+        {
+            heap_[i].slot = Index(i);
+            positions_[i] = Index(i);
+        }
+    }
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
+    [[nodiscard]] constexpr std::size_t max_size() const { return Capacity; }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return size_ == 0; }
+
+    [[nodiscard]] bool full() const { return size_ >= Capacity; }
+
+    /// O(1). The queue shall not be empty.
+    [[nodiscard]]
+    const T& top() const
+    {
+        assert(size_ > 0);
+        return heap_[0].value;
+    }
+
+    /// The handle of the top element. The queue shall not be empty.
+    [[nodiscard]]
+    Handle topHandle() const
+    {
+        assert(size_ > 0);
+        return makeHandle(heap_[0].slot);
+    }
+
+    /// If the queue is full, nothing is done and the returned handle is invalid.
+    template <typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        if (size_ >= Capacity)
+        {
+            assert(false);
+            return Handle();
+        }
+        const Index slot = heap_[size_].slot;
+        heap_[size_].value = T(std::forward<Args>(args)...);
+        ++size_;
+        siftUp(size_ - 1U);
+        return makeHandle(slot);
+    }
+
+    Handle push(const T& value) { return emplace(value); }
+    Handle push(T&& value)      { return emplace(std::move(value)); }
+
+    /// Removes the top element. The queue shall not be empty.
+    void pop()
+    {
+        assert(size_ > 0);
+        if (size_ > 0)
+        {
+            removeAt(0);
+        }
+    }
+
+    /// Removes the element and invalidates its handle. A stale handle is ignored.
+    void erase(const Handle handle)
+    {
+        assert(contains(handle));
+        if (contains(handle))
+        {
+            removeAt(positions_[handle.slot_]);
+        }
+    }
+
+    /// Replaces the value (hence the priority) of a queued element, e.g., decreases the key, in O(log n).
+    /// A stale handle is ignored rather than modifying the element that has reused its slot.
+    void update(const Handle handle, T value)
+    {
+        assert(contains(handle));
+        if (contains(handle))
+        {
+            heap_[positions_[handle.slot_]].value = std::move(value);
+            restoreAt(positions_[handle.slot_]);
+        }
+    }
+
+    [[nodiscard]]
+    const T& get(const Handle handle) const
+    {
+        assert(contains(handle));
+        return heap_[positions_[handle.slot_]].value;
+    }
+
+    /// True if the handle refers to an element that is currently in the queue.
+    [[nodiscard]]
+    bool contains(const Handle handle) const
+    {
+        return handle.isValid() &&
+               (positions_[handle.slot_] < size_) &&
+               (generations_[handle.slot_] == handle.generation_);
+    }
+
+    void clear()
+    {
+        for (std::size_t i = 0; i < size_; i++)
+        {
+            heap_[i].value = T();
+            ++generations_[heap_[i].slot];
+        }
+        size_ = 0;
+    }
+
+private:
+    [[nodiscard]] Handle makeHandle(const Index slot) const { return Handle(slot, generations_[slot]); }
+
+    [[nodiscard]]
+    static bool precedes(const T& a, const T& b)            ///< True if a is closer to the top than b
+    {
+        return Compare()(b, a);
+    }
+
+    void place(const std::size_t position, Node&& node)
+    {
+        heap_[position] = std::move(node);
+        positions_[heap_[position].slot] = Index(position);
+    }
+
+    /// Moves the element up with a hole instead of swaps; returns the final position.
+    std::size_t siftUp(std::size_t position)
+    {
+        Node node = std::move(heap_[position]);
+        while (position > 0)
+        {
+            const std::size_t parent = (position - 1U) / Arity;
+            if (!precedes(node.value, heap_[parent].value))
+            {
+                break;
+            }
+            place(position, std::move(heap_[parent]));
+            position = parent;
+        }
+        place(position, std::move(node));
+        return position;
+    }
+
+    void siftDown(std::size_t position)
+    {
+        Node node = std::move(heap_[position]);
+        while (true)
+        {
+            const std::size_t first = (position * Arity) + 1U;
+            if (first >= size_)
+            {
+                break;
+            }
+            const std::size_t last = ((first + Arity) < size_) ? (first + Arity) : size_;
+            std::size_t best = first;
+            for (std::size_t c = first + 1U; c < last; c++)
+            {
+                best = precedes(heap_[c].value, heap_[best].value) ? c : best;
+            }
+            if (!precedes(heap_[best].value, node.value))
+            {
+                break;
+            }
+            place(position, std::move(heap_[best]));
+            position = best;
+        }
+        place(position, std::move(node));
+    }
+
+    void restoreAt(const std::size_t position)
+    {
+        if (siftUp(position) == position)
+        {
+            siftDown(position);
+        }
+    }
+
+    /// The removed node is swapped with the last one, whose position then becomes free.
+    void removeAt(const std::size_t position)
+    {
+        const Index slot = heap_[position].slot;
+        --size_;
+        Node last = std::move(heap_[size_]);
+        place(size_, Node{T(), slot});      // Release the resources held by the value, if any
+        ++generations_[slot];
+        if (position < size_)
+        {
+            place(position, std::move(last));
+            restoreAt(position);
+        }
+    }
+};
+
+}
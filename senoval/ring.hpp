@@ -0,0 +1,189 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <atomic>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace senoval
+{
+/**
+ * A fixed-capacity single-producer single-consumer queue, e.g. for handing data over from an ISR to a task.
+ * The capacity must be a power of two; all of it is usable.
+ *
+ * Both sides are wait-free: an operation completes in a bounded number of steps regardless of the other side.
+ * Only atomic loads and stores of the indices are used (no read-modify-write), so it works on cores that
+ * lack atomic RMW instructions, such as ARMv6-M. The indices run freely and are masked on access.
+ * Each side keeps a private copy of the other side's index and refreshes it only when it appears to be exhausted,
+ * so in the steady state the cache line of the other side is not touched.
+ *
+ * At most one thread (or ISR) shall push and at most one shall pop at any moment.
+ * This implementation supports only trivial types: they are copied in bulk and never destroyed.
+ */
+template <typename T, std::size_t Capacity_>
+class RingBuffer
+{
+public:
+    static constexpr std::size_t Capacity = Capacity_;
+
+    static_assert(Capacity > 0, "Capacity must be positive");
+    static_assert((Capacity & (Capacity - 1U)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivial_v<T>, "This implementation supports only trivial types.");
+
+private:
+    using Index = std::size_t;
+    static constexpr Index Mask = Capacity - 1U;
+    static constexpr std::size_t IndexAlignment = detail::CacheLineAlignment<std::atomic<Index>>;
+
+    // Producer's cache line
+    alignas(IndexAlignment) std::atomic<Index> head_{0};
+    Index cached_tail_ = 0;
+
+    // Consumer's cache line
+    alignas(IndexAlignment) std::atomic<Index> tail_{0};
+    Index cached_head_ = 0;
+
+    alignas(detail::CacheLineAlignment<T>) T buf_[Capacity];    // Not initialized, like in Vector<>
+
+    /// Copies the elements from the linear array into the ring starting at the specified index, or vice versa.
+    void copyIn(const Index at, const T* const src, const std::size_t count)
+    {
+        const std::size_t offset = at & Mask;
+        const std::size_t first = ((Capacity - offset) < count) ? (Capacity - offset) : count;
+        std::memcpy(&buf_[offset], src, first * sizeof(T));
+        std::memcpy(&buf_[0], src + first, (count - first) * sizeof(T));
+    }
+
+    void copyOut(const Index at, T* const dst, const std::size_t count) const
+    {
+        const std::size_t offset = at & Mask;
+        const std::size_t first = ((Capacity - offset) < count) ? (Capacity - offset) : count;
+        std::memcpy(dst, &buf_[offset], first * sizeof(T));
+        std::memcpy(dst + first, &buf_[0], (count - first) * sizeof(T));
+    }
+
+public:
+    RingBuffer() = default;
+
+    // The indices are shared with the other side, so the object must stay where it is.
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
+    [[nodiscard]] constexpr std::size_t max_size() const { return Capacity; }
+
+    /*
+     * Producer side.
+     */
+    /// Returns false if the queue is full, in which case nothing is done.
+    [[nodiscard]]
+    bool push(const T& value)
+    {
+        return push(&value, 1) == 1;
+    }
+
+    /// Pushes as many elements as there is space for; returns the number of elements pushed.
+    std::size_t push(const T* const values, const std::size_t count)
+    {
+        const Index head = head_.load(std::memory_order_relaxed);   // Only this side writes it
+        std::size_t space = Capacity - (head - cached_tail_);
+        if (space < count)
+        {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            space = Capacity - (head - cached_tail_);
+        }
+        const std::size_t n = (space < count) ? space : count;
+        if (n > 0)
+        {
+            copyIn(head, values, n);
+            head_.store(head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    /*
+     * Consumer side.
+     */
+    /// Returns false if the queue is empty, in which case the output is not modified.
+    [[nodiscard]]
+    bool pop(T& out_value)
+    {
+        return pop(&out_value, 1) == 1;
+    }
+
+    /// Pops up to the specified number of elements; returns the number of elements popped.
+    std::size_t pop(T* const out_values, const std::size_t max_count)
+    {
+        const Index tail = tail_.load(std::memory_order_relaxed);   // Only this side writes it
+        std::size_t available = cached_head_ - tail;
+        if (available < max_count)
+        {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            available = cached_head_ - tail;
+        }
+        const std::size_t n = (available < max_count) ? available : max_count;
+        if (n > 0)
+        {
+            copyOut(tail, out_values, n);
+            tail_.store(tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    /// Discards everything that has been pushed so far. Consumer side only, like pop().
+    void clear()
+    {
+        const Index head = head_.load(std::memory_order_acquire);
+        cached_head_ = head;    // Otherwise, pop() would trust the stale copy and hand out the discarded data
+        tail_.store(head, std::memory_order_release);
+    }
+
+    /*
+     * Either side. The result may be outdated by the time it is returned if the other side is active.
+     */
+    [[nodiscard]]
+    std::size_t size() const
+    {
+        // The tail is loaded first so that the difference never underflows.
+        const Index tail = tail_.load(std::memory_order_acquire);
+        return head_.load(std::memory_order_acquire) - tail;
+    }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return size() == 0; }
+
+    [[nodiscard]] bool full() const { return size() >= Capacity; }
+};
+
+}
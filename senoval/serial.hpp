@@ -0,0 +1,431 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+namespace senoval
+{
+/**
+ * Binary serialization of scalars, Vector<>, and String<> into byte buffers, e.g., CAN or serial frames.
+ * The byte order is explicit and is a template parameter of the writer and the reader.
+ * The scalars are the arithmetic types and enums; floating point numbers are serialized as their IEEE 754 bit patterns,
+ * bool as one byte. Contiguous data in the native byte order, and all one-byte data, is copied with memcpy().
+ *
+ * A container is serialized in one of the two layouts:
+ *  - Length-prefixed: the number of elements as the smallest unsigned integer that fits Capacity (like the length
+ *    field of the container in memory), followed by the elements.
+ *  - Fixed: exactly Capacity elements; the unused tail is written as zeros. A String<> is read up to the first zero,
+ *    like a fixed-size char array; a Vector<> is always read full.
+ *
+ * The status is sticky: a write or read that does not fit is not performed at all, and all subsequent operations
+ * fail as well, so that it is enough to check isOk() once after the entire frame is done:
+ *
+ *      serial::Writer<serial::ByteOrder::Little> w(frame, sizeof(frame));
+ *      w.write(std::uint16_t(node_id));
+ *      w.writeLengthPrefixed(state);       // Vector<float, 24>
+ *      w.writeFixed(status);               // String<64>
+ *      if (w.isOk()) { send(frame, w.size()); }
+ */
+namespace serial
+{
+enum class ByteOrder : std::uint8_t
+{
+    Little,
+    Big,
+};
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+constexpr ByteOrder NativeByteOrder = ByteOrder::Big;
+#else
+constexpr ByteOrder NativeByteOrder = ByteOrder::Little;
+#endif
+
+namespace detail
+{
+template <typename T>
+struct IsScalar : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+
+template <std::size_t Size> struct UnsignedOfSize;
+template <> struct UnsignedOfSize<1> { using Type = std::uint8_t;  };
+template <> struct UnsignedOfSize<2> { using Type = std::uint16_t; };
+template <> struct UnsignedOfSize<4> { using Type = std::uint32_t; };
+template <> struct UnsignedOfSize<8> { using Type = std::uint64_t; };
+
+template <typename T>
+using BitsOf = typename UnsignedOfSize<sizeof(T)>::Type;
+
+/// Whether the in-memory representation of T can be copied as is.
+template <typename T, ByteOrder Order>
+struct IsVerbatim : std::bool_constant<(Order == NativeByteOrder) || (sizeof(T) == 1)> {};
+
+/// Anything like Vector<> or String<>: the capacity is known at compile time, the elements are scalars.
+template <typename T, typename = void>
+struct IsContainer : std::false_type {};
+
+template <typename T>
+struct IsContainer<T, std::void_t<decltype(T::Capacity), typename T::value_type,
+                                  decltype(std::declval<const T&>().data()),
+                                  decltype(std::declval<const T&>().size())>> :
+    IsScalar<typename T::value_type> {};
+
+template <typename T>
+struct IsString : std::is_same<typename T::value_type, char> {};
+
+/// The shifts are recognized by the compiler; on most targets this is a plain store, possibly with a byte swap.
+template <ByteOrder Order, typename T>
+inline void store(std::uint8_t* const out, const T value)
+{
+    using Bits = BitsOf<T>;
+    const Bits bits = senoval::detail::bitCast<Bits>(value);
+    for (std::size_t i = 0; i < sizeof(T); i++)
+    {
+        const std::size_t index = (Order == ByteOrder::Little) ? i : (sizeof(T) - 1U - i);
+        out[index] = static_cast<std::uint8_t>(bits >> (i * 8U));
+    }
+}
+
+template <ByteOrder Order, typename T>
+inline T load(const std::uint8_t* const in)
+{
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return in[0] != 0;      // Not every byte is a valid bool
+    }
+    else
+    {
+        using Bits = BitsOf<T>;
+        Bits bits = 0;
+        for (std::size_t i = 0; i < sizeof(T); i++)
+        {
+            const std::size_t index = (Order == ByteOrder::Little) ? i : (sizeof(T) - 1U - i);
+            bits = static_cast<Bits>(bits | static_cast<Bits>(static_cast<Bits>(in[index]) << (i * 8U)));
+        }
+        return senoval::detail::bitCast<T>(bits);
+    }
+}
+
+}
+
+/**
+ * Serializes into a byte buffer of a fixed size. The buffer is not owned.
+ */
+template <ByteOrder Order = ByteOrder::Little>
+class Writer
+{
+    std::uint8_t* const buffer_;
+    const std::size_t capacity_;
+    std::size_t offset_ = 0;
+    bool ok_ = true;
+
+    [[nodiscard]] bool fits(const std::size_t count, const std::size_t element_size) const
+    {
+        return ok_ && (count <= (getRemaining() / element_size));
+    }
+
+    /// Returns nullptr and sets the failure flag if there is not enough space.
+    [[nodiscard]]
+    std::uint8_t* reserve(const std::size_t count, const std::size_t element_size)
+    {
+        if (fits(count, element_size))
+        {
+            std::uint8_t* const out = buffer_ + offset_;
+            offset_ += count * element_size;
+            return out;
+        }
+        ok_ = false;
+        return nullptr;
+    }
+
+public:
+    Writer(void* const buffer, const std::size_t capacity) :
+        buffer_(static_cast<std::uint8_t*>(buffer)),
+        capacity_(capacity)
+    {
+        assert((buffer_ != nullptr) || (capacity_ == 0));
+    }
+
+    template <std::size_t N>
+    explicit Writer(std::uint8_t (&buffer)[N]) : Writer(&buffer[0], N) { }
+
+    /// The number of bytes written so far.
+    [[nodiscard]] std::size_t size()     const { return offset_; }
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+    [[nodiscard]] std::size_t getRemaining() const { return capacity_ - offset_; }
+    [[nodiscard]] const std::uint8_t* data() const { return buffer_; }
+
+    /// False if any of the operations did not fit.
+    [[nodiscard]] bool isOk() const { return ok_; }
+
+    template <typename T, typename = std::enable_if_t<detail::IsScalar<T>::value>>
+    bool write(const T value)
+    {
+        std::uint8_t* const out = reserve(1, sizeof(T));
+        if (out != nullptr)
+        {
+            detail::store<Order>(out, value);
+        }
+        return out != nullptr;
+    }
+
+    template <typename T, typename = std::enable_if_t<detail::IsScalar<T>::value>>
+    bool write(const T* const values, const std::size_t count)
+    {
+        std::uint8_t* const out = reserve(count, sizeof(T));
+        if (out != nullptr)
+        {
+            if constexpr (detail::IsVerbatim<T, Order>::value)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(out, values, count * sizeof(T));
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    detail::store<Order>(out + (i * sizeof(T)), values[i]);
+                }
+            }
+        }
+        return out != nullptr;
+    }
+
+    /// Writes zero bytes, e.g., for reserved fields.
+    bool skip(const std::size_t size)
+    {
+        std::uint8_t* const out = reserve(size, 1);
+        if ((out != nullptr) && (size > 0))
+        {
+            std::memset(out, 0, size);
+        }
+        return out != nullptr;
+    }
+
+    template <typename Container, typename = std::enable_if_t<detail::IsContainer<Container>::value>>
+    bool writeLengthPrefixed(const Container& container)
+    {
+        using T = typename Container::value_type;
+        using Prefix = senoval::detail::SmallestUnsignedFor<Container::Capacity>;
+        const std::size_t count = std::size_t(container.size());
+        // Checked up front, so that the prefix is not written alone.
+        if (fits(1, sizeof(Prefix)) && (count <= ((getRemaining() - sizeof(Prefix)) / sizeof(T))))
+        {
+            (void) write(static_cast<Prefix>(count));
+            return write(static_cast<const T*>(container.data()), count);
+        }
+        ok_ = false;
+        return false;
+    }
+
+    template <typename Container, typename = std::enable_if_t<detail::IsContainer<Container>::value>>
+    bool writeFixed(const Container& container)
+    {
+        using T = typename Container::value_type;
+        const std::size_t count = std::size_t(container.size());
+        assert(count <= Container::Capacity);
+        if (fits(Container::Capacity, sizeof(T)))
+        {
+            (void) write(static_cast<const T*>(container.data()), count);
+            return skip((Container::Capacity - count) * sizeof(T));
+        }
+        ok_ = false;
+        return false;
+    }
+};
+
+/**
+ * Deserializes from a byte buffer. The buffer is not owned.
+ * The containers are decoded in place; if the data is invalid or incomplete, the container is not modified.
+ */
+template <ByteOrder Order = ByteOrder::Little>
+class Reader
+{
+    const std::uint8_t* const buffer_;
+    const std::size_t size_;
+    std::size_t offset_ = 0;
+    bool ok_ = true;
+
+    [[nodiscard]] bool fits(const std::size_t count, const std::size_t element_size) const
+    {
+        return ok_ && (count <= (getRemaining() / element_size));
+    }
+
+    /// Returns nullptr and sets the failure flag if there is not enough data.
+    [[nodiscard]]
+    const std::uint8_t* consume(const std::size_t count, const std::size_t element_size)
+    {
+        if (fits(count, element_size))
+        {
+            const std::uint8_t* const in = buffer_ + offset_;
+            offset_ += count * element_size;
+            return in;
+        }
+        ok_ = false;
+        return nullptr;
+    }
+
+    template <typename Container>
+    static void decode(Container& out, const std::uint8_t* const in, const std::size_t count)
+    {
+        using T = typename Container::value_type;
+        if constexpr (detail::IsString<Container>::value)
+        {
+            out.clear();
+            out.append(reinterpret_cast<const char*>(in), count);
+        }
+        else
+        {
+            out.resize(count);
+            if constexpr (detail::IsVerbatim<T, Order>::value && !std::is_same_v<T, bool>)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(out.data(), in, count * sizeof(T));
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    out.data()[i] = detail::load<Order, T>(in + (i * sizeof(T)));
+                }
+            }
+        }
+    }
+
+public:
+    Reader(const void* const buffer, const std::size_t size) :
+        buffer_(static_cast<const std::uint8_t*>(buffer)),
+        size_(size)
+    {
+        assert((buffer_ != nullptr) || (size_ == 0));
+    }
+
+    template <std::size_t N>
+    explicit Reader(const std::uint8_t (&buffer)[N]) : Reader(&buffer[0], N) { }
+
+    /// The number of bytes read so far.
+    [[nodiscard]] std::size_t getOffset()    const { return offset_; }
+    [[nodiscard]] std::size_t size()         const { return size_; }
+    [[nodiscard]] std::size_t getRemaining() const { return size_ - offset_; }
+
+    /// False if any of the operations ran out of data or encountered an invalid length.
+    [[nodiscard]] bool isOk() const { return ok_; }
+
+    /// The output is not modified on failure.
+    template <typename T, typename = std::enable_if_t<detail::IsScalar<T>::value>>
+    bool read(T& out_value)
+    {
+        const std::uint8_t* const in = consume(1, sizeof(T));
+        if (in != nullptr)
+        {
+            out_value = detail::load<Order, T>(in);
+        }
+        return in != nullptr;
+    }
+
+    template <typename T, typename = std::enable_if_t<detail::IsScalar<T>::value>>
+    bool read(T* const out_values, const std::size_t count)
+    {
+        const std::uint8_t* const in = consume(count, sizeof(T));
+        if (in != nullptr)
+        {
+            if constexpr (detail::IsVerbatim<T, Order>::value && !std::is_same_v<T, bool>)
+            {
+                if (count > 0)
+                {
+                    std::memcpy(out_values, in, count * sizeof(T));
+                }
+            }
+            else
+            {
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    out_values[i] = detail::load<Order, T>(in + (i * sizeof(T)));
+                }
+            }
+        }
+        return in != nullptr;
+    }
+
+    bool skip(const std::size_t size) { return consume(size, 1) != nullptr; }
+
+    /// Fails if the length exceeds the capacity of the container, in which case the position is not advanced.
+    template <typename Container, typename = std::enable_if_t<detail::IsContainer<Container>::value>>
+    bool readLengthPrefixed(Container& out)
+    {
+        using T = typename Container::value_type;
+        using Prefix = senoval::detail::SmallestUnsignedFor<Container::Capacity>;
+        if (fits(1, sizeof(Prefix)))
+        {
+            const std::size_t count = std::size_t(detail::load<Order, Prefix>(buffer_ + offset_));
+            if ((count <= Container::Capacity) && (count <= ((getRemaining() - sizeof(Prefix)) / sizeof(T))))
+            {
+                offset_ += sizeof(Prefix);
+                decode(out, consume(count, sizeof(T)), count);
+                return true;
+            }
+        }
+        ok_ = false;
+        return false;
+    }
+
+    template <typename Container, typename = std::enable_if_t<detail::IsContainer<Container>::value>>
+    bool readFixed(Container& out)
+    {
+        using T = typename Container::value_type;
+        const std::uint8_t* const in = consume(Container::Capacity, sizeof(T));
+        if (in != nullptr)
+        {
+            std::size_t count = Container::Capacity;
+            if constexpr (detail::IsString<Container>::value)
+            {
+                const void* const terminator = std::memchr(in, 0, Container::Capacity);
+                if (terminator != nullptr)
+                {
+                    count = std::size_t(static_cast<const std::uint8_t*>(terminator) - in);
+                }
+            }
+            decode(out, in, count);
+        }
+        return in != nullptr;
+    }
+};
+
+}
+}
@@ -0,0 +1,204 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+namespace senoval
+{
+enum class SnapshotStrategy : std::uint8_t
+{
+    SeqLock,        ///< One buffer; a read is retried if a store overlaps it
+    TripleBuffer,   ///< Three buffers; a read is retried only if two stores complete during it
+};
+
+/// The objects up to this size are published with a seqlock by default; larger ones are triple-buffered.
+constexpr std::size_t SnapshotSeqLockMaxSize = 32;
+
+/**
+ * Publishes a value from one context to any number of readers without locks, e.g., from an ISR or a high-priority
+ * task to lower-priority tasks. The writer never waits; a reader gets a consistent copy, retrying if a store
+ * interfered with the copy. The value is copied word by word with relaxed atomics, so there is no data race,
+ * and only atomic loads and stores are used (no read-modify-write), so it works on ARMv6-M as well.
+ *
+ * The seqlock is the most compact, but a reader that preempts the writer (e.g., an ISR reading while the task it
+ * interrupted was storing) would never succeed; use tryLoad() there, or the triple buffer.
+ * With the triple buffer, the reader copies the latest complete buffer while the writer fills another one,
+ * so a reader never conflicts with a store in progress, only with two consecutive completed stores.
+ *
+ * At most one context shall store at any moment. T shall be trivially copyable, like Vector<> of trivial types
+ * and String<>.
+ */
+template <typename T,
+          SnapshotStrategy Strategy = (sizeof(T) <= SnapshotSeqLockMaxSize) ? SnapshotStrategy::SeqLock
+                                                                            : SnapshotStrategy::TripleBuffer>
+class Snapshot
+{
+    static_assert(std::is_trivially_copyable_v<T>, "The value is copied as raw bytes");
+
+    using Word = std::uint32_t;
+    static_assert(std::atomic<Word>::is_always_lock_free, "Word-sized atomics are required");
+
+    static constexpr std::size_t WordCount = (sizeof(T) + sizeof(Word) - 1U) / sizeof(Word);
+    static constexpr std::size_t BufferCount = (Strategy == SnapshotStrategy::SeqLock) ? 1U : 3U;
+    static constexpr std::size_t Alignment = detail::CacheLineAlignment<std::atomic<Word>>;
+
+    /*
+     * Seqlock: the state is odd while a store is in progress and is incremented by two per store.
+     * Triple buffer: the low two bits are the index of the latest complete buffer, the rest is the generation.
+     */
+    static constexpr Word TripleIndexMask = 3U;
+    static constexpr Word TripleGenerationStep = 4U;
+
+    struct alignas(Alignment) Buffer
+    {
+        std::atomic<Word> words[WordCount];
+    };
+
+    alignas(Alignment) std::atomic<Word> state_{0};
+    Buffer buffers_[BufferCount];
+
+    static void writeWords(Buffer& buffer, const T& value)
+    {
+        const auto* const src = reinterpret_cast<const unsigned char*>(&value);
+        for (std::size_t i = 0; i < WordCount; i++)
+        {
+            const std::size_t offset = i * sizeof(Word);
+            Word w = 0;
+            std::memcpy(&w, src + offset, ((sizeof(T) - offset) < sizeof(Word)) ? (sizeof(T) - offset) : sizeof(Word));
+            buffer.words[i].store(w, std::memory_order_relaxed);
+        }
+    }
+
+    static void readWords(const Buffer& buffer, Word (&out)[WordCount])
+    {
+        for (std::size_t i = 0; i < WordCount; i++)
+        {
+            out[i] = buffer.words[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    /// Returns false if the copy may be inconsistent.
+    bool read(Word (&out)[WordCount]) const
+    {
+        const Word before = state_.load(std::memory_order_acquire);
+        if constexpr (Strategy == SnapshotStrategy::SeqLock)
+        {
+            if ((before & 1U) != 0)
+            {
+                return false;
+            }
+            readWords(buffers_[0], out);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return state_.load(std::memory_order_relaxed) == before;
+        }
+        else
+        {
+            readWords(buffers_[before & TripleIndexMask], out);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // The buffer is reused by the second store after the one we have seen.
+            const Word after = state_.load(std::memory_order_relaxed);
+            return Word((after & ~TripleIndexMask) - (before & ~TripleIndexMask)) < (2U * TripleGenerationStep);
+        }
+    }
+
+public:
+    explicit Snapshot(const T& initial = T())
+    {
+        writeWords(buffers_[0], initial);
+    }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    /// Never waits. Shall not be invoked concurrently with itself.
+    void store(const T& value)
+    {
+        const Word state = state_.load(std::memory_order_relaxed);     // Only this side writes it
+        if constexpr (Strategy == SnapshotStrategy::SeqLock)
+        {
+            state_.store(state + 1U, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);        // The odd state goes before the data
+            writeWords(buffers_[0], value);
+            state_.store(state + 2U, std::memory_order_release);
+        }
+        else
+        {
+            const Word index = ((state & TripleIndexMask) + 1U) % 3U;
+            std::atomic_thread_fence(std::memory_order_release);        // The previous state goes before the data
+            writeWords(buffers_[index], value);
+            state_.store(Word(((state & ~TripleIndexMask) + TripleGenerationStep) | index),
+                         std::memory_order_release);
+        }
+    }
+
+    /// Makes one attempt; returns false if a store interfered, in which case the output is not modified.
+    [[nodiscard]]
+    bool tryLoad(T& out_value) const
+    {
+        Word words[WordCount];
+        const bool ok = read(words);
+        if (ok)
+        {
+            std::memcpy(static_cast<void*>(&out_value), &words[0], sizeof(T));
+        }
+        return ok;
+    }
+
+    /// Retries until a consistent copy is obtained; see the class documentation regarding preemption.
+    [[nodiscard]]
+    T load() const
+    {
+        Word words[WordCount];
+        while (!read(words))
+        {
+            // The writer is busy; try again
+        }
+        T out{};
+        std::memcpy(static_cast<void*>(&out), &words[0], sizeof(T));
+        return out;
+    }
+
+    /// The number of stores so far; wraps around. Useful for detecting updates without copying the value.
+    [[nodiscard]]
+    std::uint32_t getGeneration() const
+    {
+        const Word state = state_.load(std::memory_order_acquire);
+        return (Strategy == SnapshotStrategy::SeqLock) ? Word(state >> 1U) : Word(state >> 2U);
+    }
+};
+
+}
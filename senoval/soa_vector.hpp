@@ -0,0 +1,213 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include "span.hpp"
+#include <cassert>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace senoval
+{
+namespace detail
+{
+/// The index makes the bases distinct when several fields have the same type.
+template <std::size_t Index, typename T, std::size_t Capacity>
+struct alignas(CacheLineAlignment<T>) SoAColumn
+{
+    T items[Capacity];      // Not zero-initialized; std::tuple<> would value-initialize it
+};
+
+template <std::size_t Capacity, typename Indices, typename... Fields>
+struct SoAColumns;
+
+template <std::size_t Capacity, std::size_t... Is, typename... Fields>
+struct SoAColumns<Capacity, std::index_sequence<Is...>, Fields...> : SoAColumn<Is, Fields, Capacity>... {};
+
+}
+
+/**
+ * A fixed-capacity sequence of records stored as a structure of arrays: each field lives in its own array,
+ * so that an algorithm that walks one field across all records touches only the memory of that field
+ * and can be vectorized. The push/pop/size semantics are those of Vector<>.
+ *
+ *      SoAVector<4096, std::uint32_t, float, float, float> log;    // t, x, y, z
+ *      log.push_back(t, x, y, z);
+ *      for (float& x : log.field<1>()) { ... }
+ *      auto [t, x, y, z] = log[0];                                 // References
+ *
+ * Each field array is aligned to detail::CacheLineAlignment<T>: at a cache line boundary where SENOVAL_CACHE_LINE_SIZE
+ * allows it, which keeps the data pointer suitably aligned for SIMD loads, and never weaker than alignof(T).
+ * Only trivial field types are supported; like Vector<>, the storage is not zero-initialized.
+ */
+template <std::size_t Capacity, typename... Fields>
+class SoAVector
+{
+    static_assert(Capacity > 0, "Capacity must be positive");
+    static_assert(sizeof...(Fields) > 0, "At least one field is required");
+    static_assert((std::is_trivial_v<Fields> && ...), "Only trivial field types are supported");
+
+    using Indices = std::index_sequence_for<Fields...>;
+
+    template <std::size_t I>
+    [[nodiscard]] auto& getColumn()
+    {
+        return static_cast<detail::SoAColumn<I, FieldType<I>, Capacity>&>(columns_).items;
+    }
+
+    template <std::size_t I>
+    [[nodiscard]] const auto& getColumn() const
+    {
+        return const_cast<SoAVector*>(this)->getColumn<I>();
+    }
+
+    template <std::size_t... Is>
+    [[nodiscard]] std::tuple<Fields&...> getRow(const std::size_t index, std::index_sequence<Is...>)
+    {
+        return std::tuple<Fields&...>(getColumn<Is>()[index]...);
+    }
+
+    template <std::size_t... Is>
+    [[nodiscard]] std::tuple<const Fields&...> getRow(const std::size_t index, std::index_sequence<Is...>) const
+    {
+        return std::tuple<const Fields&...>(getColumn<Is>()[index]...);
+    }
+
+    template <std::size_t... Is, typename... Args>
+    void setRow(const std::size_t index, std::index_sequence<Is...>, Args&&... values)
+    {
+        ((getColumn<Is>()[index] = std::forward<Args>(values)), ...);
+    }
+
+    detail::SoAColumns<Capacity, Indices, Fields...> columns_;
+    detail::SmallestUnsignedFor<Capacity> len_ = 0;
+
+public:
+    static constexpr std::size_t FieldCount = sizeof...(Fields);
+
+    template <std::size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
+    [[nodiscard]] constexpr std::size_t max_size() const { return Capacity; }
+
+    [[nodiscard]] std::size_t size() const { return len_; }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return len_ == 0; }
+
+    void clear() { len_ = 0; }
+
+    /// New records are value-initialized, like in Vector<>.
+    void resize(const std::size_t count)
+    {
+        assert(count <= Capacity);
+        const std::size_t new_length = (count < Capacity) ? count : Capacity;
+        for (std::size_t i = len_; i < new_length; i++)
+        {
+            setRow(i, Indices{}, Fields{}...);
+        }
+        len_ = static_cast<decltype(len_)>(new_length);
+    }
+
+    /// One value per field.
+    template <typename... Args, typename = std::enable_if_t<sizeof...(Args) == FieldCount>>
+    void push_back(Args&&... values)
+    {
+        assert(len_ < Capacity);
+        if (len_ < Capacity)
+        {
+            setRow(len_, Indices{}, std::forward<Args>(values)...);
+            len_++;
+        }
+    }
+
+    void push_back(const value_type& row)
+    {
+        std::apply([this](const Fields&... values) { push_back(values...); }, row);
+    }
+
+    void pop_back()
+    {
+        assert(len_ > 0);
+        if (len_ > 0)
+        {
+            len_--;
+        }
+    }
+
+    /*
+     * Row access. The references can be assigned through, e.g., soa[i] = std::make_tuple(...).
+     */
+    [[nodiscard]]
+    reference operator[](const std::size_t index)
+    {
+        assert(index < len_);
+        return getRow(index, Indices{});
+    }
+
+    [[nodiscard]]
+    const_reference operator[](const std::size_t index) const
+    {
+        assert(index < len_);
+        return getRow(index, Indices{});
+    }
+
+    [[nodiscard]] reference       front()       { return operator[](0); }
+    [[nodiscard]] const_reference front() const { return operator[](0); }
+
+    [[nodiscard]] reference       back()       { return operator[](len_ - 1U); }
+    [[nodiscard]] const_reference back() const { return operator[](len_ - 1U); }
+
+    /*
+     * Field access. The span covers the current size; the pointer is aligned to detail::CacheLineAlignment<T>.
+     */
+    template <std::size_t I>
+    [[nodiscard]] Span<FieldType<I>> field() { return Span<FieldType<I>>(data<I>(), len_); }
+
+    template <std::size_t I>
+    [[nodiscard]] Span<const FieldType<I>> field() const { return Span<const FieldType<I>>(data<I>(), len_); }
+
+    template <std::size_t I>
+    [[nodiscard]] FieldType<I>* data() { return &getColumn<I>()[0]; }
+
+    template <std::size_t I>
+    [[nodiscard]] const FieldType<I>* data() const { return &getColumn<I>()[0]; }
+};
+
+}
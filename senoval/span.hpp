@@ -0,0 +1,137 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+
+namespace senoval
+{
+namespace detail
+{
+/// Same rule as std::span<>: only qualification conversions of the element type are allowed, no derived-to-base.
+template <typename From, typename To>
+constexpr bool IsSpanCompatible = std::is_convertible_v<From(*)[], To(*)[]>;
+
+template <typename Container, typename T, typename = void>
+struct IsSpanSource : std::false_type {};
+
+template <typename Container, typename T>
+struct IsSpanSource<Container, T, std::enable_if_t<
+    IsSpanCompatible<std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))>, T> &&
+    std::is_integral_v<decltype(std::size(std::declval<Container&>()))>>> : std::true_type {};
+
+}
+
+/**
+ * A non-owning view of a contiguous sequence, a subset of C++20 std::span<> with a dynamic extent.
+ * Like StringView, it does not extend the lifetime of the referenced data.
+ */
+template <typename T>
+class Span
+{
+    T* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+
+    constexpr Span() = default;
+
+    constexpr Span(T* const data, const std::size_t size) :
+        data_(data),
+        size_(size)
+    {
+        assert((data_ != nullptr) || (size_ == 0));
+    }
+
+    template <std::size_t N>
+    constexpr Span(T (&array)[N]) :  // NOLINT
+        data_(&array[0]),
+        size_(N)
+    { }
+
+    /// Any contiguous container, e.g. Vector, String or std::array; the element types shall match up to const.
+    template <typename Container, typename = std::enable_if_t<detail::IsSpanSource<Container, T>::value>>
+    constexpr Span(Container& container) :  // NOLINT
+        data_(std::data(container)),
+        size_(std::size_t(std::size(container)))
+    { }
+
+    /// Span<T> converts to Span<const T>.
+    template <typename U, typename = std::enable_if_t<detail::IsSpanCompatible<U, T>>>
+    constexpr Span(const Span<U>& other) :  // NOLINT
+        data_(other.data()),
+        size_(other.size())
+    { }
+
+    [[nodiscard]] constexpr T* data() const { return data_; }
+    [[nodiscard]] constexpr std::size_t size() const { return size_; }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    constexpr bool empty() const { return size_ == 0; }
+
+    [[nodiscard]] constexpr T* begin() const { return data_; }
+    [[nodiscard]] constexpr T* end()   const { return data_ + size_; }
+
+    [[nodiscard]]
+    constexpr T& operator[](const std::size_t index) const
+    {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    [[nodiscard]] constexpr T& front() const { return operator[](0); }
+    [[nodiscard]] constexpr T& back()  const { return operator[](size_ - 1U); }
+
+    /// The count is clamped to the end of the span; the offset shall not exceed the size.
+    [[nodiscard]]
+    constexpr Span subspan(const std::size_t offset, const std::size_t count = SIZE_MAX) const
+    {
+        assert(offset <= size_);
+        return Span(data_ + offset, (count < (size_ - offset)) ? count : (size_ - offset));
+    }
+
+    [[nodiscard]] constexpr Span first(const std::size_t count) const { return subspan(0, count); }
+
+    [[nodiscard]]
+    constexpr Span last(const std::size_t count) const
+    {
+        return subspan((count < size_) ? (size_ - count) : 0);
+    }
+};
+
+}
@@ -0,0 +1,260 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include "string_view.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+
+namespace senoval
+{
+namespace detail
+{
+/*
+ * Invalid input of StaticMap<>. These are deliberately not constexpr: if reached during constant evaluation, the build
+ * fails in every configuration, regardless of NDEBUG, with the name of the function in the error message.
+ * At run time, the program is aborted.
+ */
+[[noreturn]] inline void staticMapHasDuplicateKeys() { std::abort(); }
+[[noreturn]] inline void staticMapKeysCannotBeSeparated() { std::abort(); }
+}
+
+/**
+ * An immutable map from strings to values built at compile time with a minimal perfect hash (hash and displace):
+ * the keys are distributed over a few buckets, and each bucket stores a seed that maps all of its keys
+ * into distinct slots. A lookup hashes the key once, mixes the hash with the seed of its bucket,
+ * and compares the key with the single candidate in that slot; there are no collisions and no probing.
+ *
+ * Use makeStaticMap() to build one; declare the result constexpr so that it is placed into ROM:
+ *
+ *      static constexpr auto Units = makeStaticMap<int>({{"m", 1}, {"km", 1000}, {"mm", -1000}});
+ *      static_assert(*Units.get("km") == 1000);
+ *      const int* scale = Units.get(String<8>("mm"));
+ *
+ * The keys are referenced, not copied; string literals are fine. V must be default-constructible in constexpr.
+ */
+template <typename V, std::size_t Size_>
+class StaticMap
+{
+public:
+    static constexpr std::size_t Size = Size_;
+
+    static_assert(Size > 0, "The map shall not be empty");
+
+    struct Entry
+    {
+        StringView key;
+        V value{};
+    };
+
+    using value_type = Entry;
+    using const_iterator = const Entry*;
+
+    /// Prefer makeStaticMap().
+    explicit constexpr StaticMap(const std::pair<StringView, V> (&entries)[Size])
+    {
+        std::uint32_t hashes[Size]{};
+        for (std::size_t i = 0; i < Size; i++)
+        {
+            hashes[i] = entries[i].first.hash();
+            for (std::size_t k = 0; k < i; k++)
+            {
+                // Either a duplicate key or a 32-bit collision; the latter is astronomically unlikely.
+                if (hashes[k] == hashes[i])
+                {
+                    detail::staticMapHasDuplicateKeys();
+                }
+            }
+        }
+
+        // Group the keys by bucket (counting sort) so that each bucket can be processed without a full scan.
+        std::size_t bucket_offsets[Buckets + 1U]{};
+        for (std::size_t i = 0; i < Size; i++)
+        {
+            bucket_offsets[getBucket(hashes[i]) + 1U]++;
+        }
+        for (std::size_t b = 0; b < Buckets; b++)
+        {
+            bucket_offsets[b + 1U] += bucket_offsets[b];
+        }
+        std::size_t order[Size]{};
+        {
+            std::size_t fill[Buckets]{};
+            for (std::size_t i = 0; i < Size; i++)
+            {
+                const std::size_t b = getBucket(hashes[i]);
+                order[bucket_offsets[b] + fill[b]++] = i;
+            }
+        }
+
+        // The largest buckets are placed first while most of the slots are still free.
+        bool taken[Size]{};
+        bool placed[Buckets]{};
+        std::size_t scratch[Size]{};
+        for (std::size_t iteration = 0; iteration < Buckets; iteration++)
+        {
+            std::size_t bucket = 0;
+            std::size_t largest = 0;
+            for (std::size_t b = 0; b < Buckets; b++)
+            {
+                const std::size_t bucket_size = bucket_offsets[b + 1U] - bucket_offsets[b];
+                if (!placed[b] && (placed[bucket] || (bucket_size > largest)))
+                {
+                    bucket = b;
+                    largest = bucket_size;
+                }
+            }
+            placed[bucket] = true;
+            const std::size_t begin = bucket_offsets[bucket];
+            const std::size_t end = bucket_offsets[bucket + 1U];
+            const Seed seed = findSeed(hashes, &order[begin], end - begin, taken, scratch);
+            seeds_[bucket] = seed;
+            for (std::size_t k = begin; k < end; k++)
+            {
+                const std::size_t i = order[k];
+                const std::size_t slot = getSlot(hashes[i], seed);
+                taken[slot] = true;
+                entries_[slot].key = entries[i].first;
+                entries_[slot].value = entries[i].second;
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const { return Size; }
+
+    [[nodiscard]] constexpr const_iterator begin() const { return &entries_[0]; }
+    [[nodiscard]] constexpr const_iterator end()   const { return &entries_[0] + Size; }
+
+    /// Returns end() if there is no such key.
+    [[nodiscard]]
+    constexpr const_iterator find(const StringView key) const
+    {
+        const std::uint32_t hash = key.hash();
+        const Entry& e = entries_[getSlot(hash, seeds_[getBucket(hash)])];
+        return (e.key == key) ? &e : end();
+    }
+
+    [[nodiscard]]
+    constexpr bool contains(const StringView key) const { return find(key) != end(); }
+
+    /// Pointer to the value or nullptr if there is no such key.
+    [[nodiscard]]
+    constexpr const V* get(const StringView key) const
+    {
+        const const_iterator it = find(key);
+        return (it == end()) ? nullptr : &it->value;
+    }
+
+    /**
+     * The reverse mapping, e.g., from an enum to its name. This is a linear search.
+     * Returns an empty view if there is no such value.
+     */
+    [[nodiscard]]
+    constexpr StringView findKey(const V& value) const
+    {
+        for (const Entry& e : entries_)
+        {
+            if (e.value == value)
+            {
+                return e.key;
+            }
+        }
+        return {};
+    }
+
+private:
+    /// About four keys per bucket on average is a good balance between the size of the table and the build time.
+    static constexpr std::size_t Buckets = (Size + 3U) / 4U;
+
+    using Seed = std::uint16_t;
+
+    Entry entries_[Size]{};
+    Seed seeds_[Buckets]{};
+
+    [[nodiscard]]
+    static constexpr std::size_t getBucket(const std::uint32_t hash)
+    {
+        return hash % Buckets;
+    }
+
+    [[nodiscard]]
+    static constexpr std::size_t getSlot(const std::uint32_t hash, const Seed seed)
+    {
+        return detail::mixBits((std::uint64_t(seed) << 32U) | hash) % Size;
+    }
+
+    /// Finds the seed that maps the keys of the bucket into distinct free slots.
+    static constexpr Seed findSeed(const std::uint32_t (&hashes)[Size],
+                                   const std::size_t* const members,
+                                   const std::size_t count,
+                                   const bool (&taken)[Size],
+                                   std::size_t (&scratch)[Size])
+    {
+        for (std::uint32_t seed = 0; seed <= std::numeric_limits<Seed>::max(); seed++)
+        {
+            bool ok = true;
+            for (std::size_t k = 0; (k < count) && ok; k++)
+            {
+                scratch[k] = getSlot(hashes[members[k]], Seed(seed));
+                ok = !taken[scratch[k]];
+                for (std::size_t j = 0; (j < k) && ok; j++)
+                {
+                    ok = scratch[j] != scratch[k];
+                }
+            }
+            if (ok)
+            {
+                return Seed(seed);
+            }
+        }
+        detail::staticMapKeysCannotBeSeparated();      // Should never happen in practice
+    }
+};
+
+/**
+ * Builds a StaticMap; see there. The number of entries is deduced from the initializer:
+ *
+ *      constexpr auto Commands = makeStaticMap<Command>({{"reboot", Command::Reboot}, {"status", Command::Status}});
+ *
+ * Duplicate keys are detected and produce a compilation error when the result is constexpr, also with NDEBUG.
+ */
+template <typename V, std::size_t N>
+[[nodiscard]]
+constexpr StaticMap<V, N> makeStaticMap(const std::pair<StringView, V> (&entries)[N])
+{
+    return StaticMap<V, N>(entries);
+}
+
+}
@@ -29,16 +29,122 @@
 # error "This library requires C++17 or newer"
 #endif
 
+#include "common.hpp"
+#include "instrumentation.hpp"
+#include "overflow.hpp"
+#include "string_view.hpp"
 #include <algorithm>
 #include <iterator>
 #include <cstring>
+#include <string.h>     // strnlen()
 #include <cassert>
 #include <cstdint>
-#include <cctype>
+#include <functional>
+#include <utility>
+#include <limits>
+#include <type_traits>
 
 
 namespace senoval
 {
+namespace detail
+{
+/**
+ * strnlen() is not part of the C++ standard, but it is provided by every C library we care about
+ * (glibc, newlib, musl, MSVC CRT), and it is much faster than a naive loop.
+ * The source is never scanned beyond max_length characters, so it need not be null-terminated.
+ */
+constexpr std::size_t getBoundedLength(const char* const s, const std::size_t max_length)
+{
+    if (isConstantEvaluated())
+    {
+        std::size_t i = 0;
+        while ((i < max_length) && (s[i] != '\0'))
+        {
+            ++i;
+        }
+        return i;
+    }
+    return ::strnlen(s, max_length);
+}
+
+/// memmove() that can be used in constant expressions. The ranges may overlap if dst precedes src,
+/// as in "s = s.c_str() + 1", where the string is cleared before the suffix is copied to the front.
+constexpr void copyChars(char* const dst, const char* const src, const std::size_t count)
+{
+    if (isConstantEvaluated())
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            dst[i] = src[i];
+        }
+    }
+    else
+    {
+        std::memmove(dst, src, count);
+    }
+}
+
+template <typename T, typename = void>
+struct HasDataAndSize : std::false_type {};
+
+template <typename T>
+struct HasDataAndSize<T, std::enable_if_t<
+    std::is_convertible_v<decltype(std::declval<const T&>().data()), const char*> &&
+    std::is_integral_v<decltype(std::declval<const T&>().size())>>> : std::true_type {};
+
+template <typename T, typename = void>
+struct HasCStr : std::false_type {};
+
+template <typename T>
+struct HasCStr<T, std::enable_if_t<
+    std::is_convertible_v<decltype(std::declval<const T&>().c_str()), const char*>>> : std::true_type {};
+
+template <typename T, typename = void>
+struct HasCStrAndSize : std::false_type {};
+
+template <typename T>
+struct HasCStrAndSize<T, std::enable_if_t<
+    HasCStr<T>::value && std::is_integral_v<decltype(std::declval<const T&>().size())>>> : std::true_type {};
+
+/// True if the type can be appended to a String<> as a whole.
+template <typename T>
+struct IsCharSequence : std::bool_constant<HasDataAndSize<T>::value || HasCStr<T>::value> {};
+
+}
+
+namespace detail
+{
+inline constexpr char DigitAlphabet[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+/// Two decimal digits per entry; allows the conversion to do one division per two digits.
+inline constexpr char DecimalDigitPairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/// The unsigned counterpart of an integer type; bool is treated as unsigned char.
+template <typename T>
+struct MakeUnsigned { using Type = std::make_unsigned_t<T>; };
+
+template <>
+struct MakeUnsigned<bool> { using Type = unsigned char; };
+
+template <std::uint8_t Radix>
+constexpr std::uint8_t getRadixShift()
+{
+    std::uint8_t shift = 0;
+    while ((1U << shift) < Radix)
+    {
+        ++shift;
+    }
+    return ((1U << shift) == Radix) ? shift : 0;    // Zero if the radix is not a power of two
+}
+
+}
+
 /**
  * Converts any signed or unsigned integer or boolean to string and returns it by value.
  * The argument must be of integral type, otherwise the call will be rejected by SFINAE.
@@ -46,6 +152,7 @@ namespace senoval
  *      intToString(var)
  *      intToString<16>(var)
  *      intToString<2>(var).c_str()
+ *      intToString<16>(var, 8)         // Zero-padded to at least 8 digits, e.g. "0000abcd"
  * It is safe to obtain a reference to the returned string and pass it to another function as an argument,
  * which enables use cases like this (this example is somewhat made up, but it conveys the idea nicely):
  *      print("%s", intToString(123).c_str());
@@ -53,32 +160,48 @@ namespace senoval
  * More info on rvalue references:
  *      https://herbsutter.com/2008/01/01/gotw-88-a-candidate-for-the-most-important-const/
  *      http://stackoverflow.com/questions/584824/guaranteed-lifetime-of-temporary-in-c
+ *
+ * The minimum number of digits does not include the minus sign; it is limited to what the type can
+ * represent in the selected radix (e.g., at most 10 digits for a 32-bit type in radix 10).
+ * Radix 10 is converted two digits per division; power-of-two radices use shifts and masks instead of division.
+ * Values not wider than 32 bits are handled with 32-bit arithmetic regardless of their type.
  */
 template <
     std::uint8_t Radix = 10,
     typename T,
     typename = std::enable_if_t<std::is_integral<T>::value>>
-inline constexpr auto convertIntToString(T number)
+inline constexpr auto convertIntToString(T number, const std::uint16_t min_digits = 0)
 {
-    static_assert(Radix >= 1, "Radix must be positive");
+    static_assert(Radix >= 2, "Radix must be at least 2");
+    static_assert(Radix < sizeof(detail::DigitAlphabet), "Radix is too large");
 
     // Plus 1 to round up, see the standard for details.
     constexpr std::uint16_t MaxChars =
         std::uint16_t(((Radix >= 10) ? std::numeric_limits<T>::digits10 : std::numeric_limits<T>::digits) +
                       1 + (std::is_signed<T>::value ? 1 : 0));
 
+    constexpr std::uint16_t MaxDigits = std::uint16_t(MaxChars - (std::is_signed<T>::value ? 1 : 0));
+
+    // The arithmetic is performed on unsigned values of at least 32 bits, which is the native width on
+    // all platforms of interest; 64-bit arithmetic is used only with 64-bit arguments.
+    using Unsigned = typename detail::MakeUnsigned<T>::Type;
+    using Word = std::conditional_t<(sizeof(Unsigned) <= sizeof(std::uint32_t)), std::uint32_t, Unsigned>;
+
     class Container
     {
         std::uint16_t offset_;
         char storage_[MaxChars + 1]{};   // Plus 1 because of zero termination.
 
+        constexpr void put(const char c)
+        {
+            assert(offset_ > 0);
+            storage_[--offset_] = c;
+        }
+
     public:
-        explicit constexpr Container(T x) :
+        constexpr Container(T x, std::uint16_t min_digits) :
             offset_(MaxChars)          // Field initialization is not working in GCC in this context, not sure why.
         {
-            constexpr char Alphabet[] = "0123456789abcdefghijklmnopqrstuvwxyz";
-            static_assert(Radix <= (sizeof(Alphabet) / sizeof(Alphabet[0])), "Radix is too large");
-
             bool negative = false;
             if constexpr (std::is_signed<T>::value)
             {
@@ -86,104 +209,1331 @@ inline constexpr auto convertIntToString(T number)
                 negative = (x < 0);
             }
 
-            do
-            {
-                assert(offset_ > 0);
+            // The magnitude is computed in unsigned arithmetic, which is well-defined for the most negative value.
+            // All further operations are safe from the signed division pitfalls.
+            Word m = Word(Unsigned(x));
+            if (negative)
+            {
+                m = Word(Unsigned(Unsigned(0U) - Unsigned(x)));
+            }
+
+            constexpr std::uint8_t Shift = detail::getRadixShift<Radix>();
+            if constexpr (Radix == 10)
+            {
+                while (m >= 100U)
+                {
+                    const Word q = Word(m / 100U);
+                    const std::size_t index = std::size_t(m - (q * 100U)) * 2U;
+                    m = q;
+                    put(detail::DecimalDigitPairs[index + 1U]);
+                    put(detail::DecimalDigitPairs[index]);
+                }
+                if (m >= 10U)
+                {
+                    put(detail::DecimalDigitPairs[(std::size_t(m) * 2U) + 1U]);
+                    put(detail::DecimalDigitPairs[std::size_t(m) * 2U]);
+                }
+                else
+                {
+                    put(detail::DigitAlphabet[m]);
+                }
+            }
+            else if constexpr (Shift > 0)
+            {
+                do
+                {
+                    put(detail::DigitAlphabet[m & (Radix - 1U)]);
+                    m = Word(m >> Shift);
+                }
+                while (m != 0);
+            }
+            else
+            {
+                do
+                {
+                    const Word q = Word(m / Radix);
+                    put(detail::DigitAlphabet[m - (q * Radix)]);
+                    m = q;
+                }
+                while (m != 0);
+            }
+
+            // The padding is written in one go from a precomputed start, which keeps the index visibly in bounds.
+            min_digits = (min_digits > MaxDigits) ? MaxDigits : min_digits;
+            if (length() < min_digits)
+            {
+                const std::uint16_t pad = std::uint16_t(min_digits - length());
+                assert(pad <= offset_);
+                offset_ = std::uint16_t(offset_ - pad);
+                for (std::uint16_t i = 0; i < pad; i++)
+                {
+                    storage_[offset_ + i] = '0';
+                }
+            }
+
+            if (negative)
+            {
+                put('-');
+            }
+
+            assert(offset_ < MaxChars);                 // Making sure there was no overflow.
+        }
+
+        constexpr const char* c_str() const { return &storage_[offset_]; }
+
+        constexpr operator const char* () const { return this->c_str(); }
+
+        constexpr std::uint16_t length() const { return std::uint16_t(MaxChars - offset_); }
+        constexpr std::uint16_t size() const { return length(); }
+
+        constexpr std::uint16_t capacity() const { return MaxChars; }
+        constexpr std::uint16_t max_size() const { return MaxChars; }
+    };
+
+    return Container(number, min_digits);
+}
+
+namespace detail
+{
+/**
+ * Implementation of the Grisu2 algorithm by Florian Loitsch:
+ *  "Printing Floating-Point Numbers Quickly and Accurately with Integers", PLDI 2010.
+ * The output is guaranteed to round-trip; it is also the shortest possible representation for
+ * the overwhelming majority of inputs (all but a fraction of a percent, where one extra digit may be emitted).
+ * Only 64-bit integer arithmetic is used, no big numbers, no libc, no floating point math.
+ */
+namespace grisu
+{
+/// A floating point number f * 2^e, where f is an unsigned 64-bit integer.
+struct DiyFP
+{
+    std::uint64_t f = 0;
+    std::int32_t  e = 0;
+
+    constexpr DiyFP(const std::uint64_t f_, const std::int32_t e_) : f(f_), e(e_) { }
+
+    /// The exponents must be equal and x.f >= y.f.
+    static constexpr DiyFP subtract(const DiyFP& x, const DiyFP& y)
+    {
+        assert((x.e == y.e) && (x.f >= y.f));
+        return DiyFP(x.f - y.f, x.e);
+    }
+
+    /// The product rounded to 64 bits.
+    static constexpr DiyFP multiply(const DiyFP& x, const DiyFP& y)
+    {
+        const std::uint64_t x_lo = x.f & 0xFFFFFFFFU;
+        const std::uint64_t x_hi = x.f >> 32U;
+        const std::uint64_t y_lo = y.f & 0xFFFFFFFFU;
+        const std::uint64_t y_hi = y.f >> 32U;
+
+        const std::uint64_t p0 = x_lo * y_lo;
+        const std::uint64_t p1 = x_lo * y_hi;
+        const std::uint64_t p2 = x_hi * y_lo;
+        const std::uint64_t p3 = x_hi * y_hi;
+
+        std::uint64_t middle = (p0 >> 32U) + (p1 & 0xFFFFFFFFU) + (p2 & 0xFFFFFFFFU);
+        middle += std::uint64_t(1) << 31U;      // Round half up
+
+        const std::uint64_t high = p3 + (p1 >> 32U) + (p2 >> 32U) + (middle >> 32U);
+        return DiyFP(high, x.e + y.e + 64);
+    }
+
+    static constexpr DiyFP normalize(DiyFP x)
+    {
+        assert(x.f != 0);
+        while ((x.f >> 63U) == 0)
+        {
+            x.f <<= 1U;
+            x.e--;
+        }
+        return x;
+    }
+
+    static constexpr DiyFP normalizeTo(const DiyFP& x, const std::int32_t target_exponent)
+    {
+        const std::int32_t delta = x.e - target_exponent;
+        assert((delta >= 0) && (((x.f << std::uint32_t(delta)) >> std::uint32_t(delta)) == x.f));
+        return DiyFP(x.f << std::uint32_t(delta), target_exponent);
+    }
+};
+
+/// The value v and its boundaries m- and m+; all three have the same exponent.
+struct Boundaries
+{
+    DiyFP w;
+    DiyFP minus;
+    DiyFP plus;
+};
+
+/// The value must be finite and positive.
+template <typename F>
+inline Boundaries computeBoundaries(const F value)
+{
+    static_assert(std::numeric_limits<F>::is_iec559, "IEEE 754 floating point is required");
+    using Bits = std::conditional_t<(sizeof(F) == sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+    static_assert(sizeof(Bits) == sizeof(F));
+
+    constexpr std::int32_t Precision = std::numeric_limits<F>::digits;     // Including the hidden bit
+    constexpr std::int32_t Bias = std::numeric_limits<F>::max_exponent - 1 + (Precision - 1);
+    constexpr std::int32_t MinExponent = 1 - Bias;
+    constexpr std::uint64_t HiddenBit = std::uint64_t(1) << std::uint32_t(Precision - 1);
+
+    Bits bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint64_t biased_exponent = std::uint64_t(bits) >> std::uint32_t(Precision - 1);
+    const std::uint64_t fraction = std::uint64_t(bits) & (HiddenBit - 1U);
+
+    const bool denormal = biased_exponent == 0;
+    const DiyFP v = denormal ? DiyFP(fraction, MinExponent)
+                             : DiyFP(fraction + HiddenBit, std::int32_t(biased_exponent) - Bias);
+
+    // If the fraction is zero, the distance to the preceding value is half the distance to the next one.
+    const bool lower_boundary_is_closer = (fraction == 0) && (biased_exponent > 1);
+    const DiyFP m_plus(2U * v.f + 1U, v.e - 1);
+    const DiyFP m_minus = lower_boundary_is_closer ? DiyFP(4U * v.f - 1U, v.e - 2) : DiyFP(2U * v.f - 1U, v.e - 1);
+
+    const DiyFP w_plus = DiyFP::normalize(m_plus);
+    const DiyFP w_minus = DiyFP::normalizeTo(m_minus, w_plus.e);
+    return {DiyFP::normalize(v), w_minus, w_plus};
+}
+
+struct CachedPower
+{
+    std::uint64_t f;
+    std::int16_t  e;
+    std::int16_t  k;
+};
+
+/// Normalized approximations of 10^k for k in [-300, 324] with step 8.
+inline constexpr CachedPower CachedPowers[] =
+{
+    { 0xAB70FE17C79AC6CAULL, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4FULL, -1034, -292 },
+    { 0xBE5691EF416BD60CULL, -1007, -284 },
+    { 0x8DD01FAD907FFC3CULL,  -980, -276 },
+    { 0xD3515C2831559A83ULL,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5ULL,  -927, -260 },
+    { 0xEA9C227723EE8BCBULL,  -901, -252 },
+    { 0xAECC49914078536DULL,  -874, -244 },
+    { 0x823C12795DB6CE57ULL,  -847, -236 },
+    { 0xC21094364DFB5637ULL,  -821, -228 },
+    { 0x9096EA6F3848984FULL,  -794, -220 },
+    { 0xD77485CB25823AC7ULL,  -768, -212 },
+    { 0xA086CFCD97BF97F4ULL,  -741, -204 },
+    { 0xEF340A98172AACE5ULL,  -715, -196 },
+    { 0xB23867FB2A35B28EULL,  -688, -188 },
+    { 0x84C8D4DFD2C63F3BULL,  -661, -180 },
+    { 0xC5DD44271AD3CDBAULL,  -635, -172 },
+    { 0x936B9FCEBB25C996ULL,  -608, -164 },
+    { 0xDBAC6C247D62A584ULL,  -582, -156 },
+    { 0xA3AB66580D5FDAF6ULL,  -555, -148 },
+    { 0xF3E2F893DEC3F126ULL,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8ULL,  -502, -132 },
+    { 0x87625F056C7C4A8BULL,  -475, -124 },
+    { 0xC9BCFF6034C13053ULL,  -449, -116 },
+    { 0x964E858C91BA2655ULL,  -422, -108 },
+    { 0xDFF9772470297EBDULL,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88FULL,  -369,  -92 },
+    { 0xF8A95FCF88747D94ULL,  -343,  -84 },
+    { 0xB94470938FA89BCFULL,  -316,  -76 },
+    { 0x8A08F0F8BF0F156BULL,  -289,  -68 },
+    { 0xCDB02555653131B6ULL,  -263,  -60 },
+    { 0x993FE2C6D07B7FACULL,  -236,  -52 },
+    { 0xE45C10C42A2B3B06ULL,  -210,  -44 },
+    { 0xAA242499697392D3ULL,  -183,  -36 },
+    { 0xFD87B5F28300CA0EULL,  -157,  -28 },
+    { 0xBCE5086492111AEBULL,  -130,  -20 },
+    { 0x8CBCCC096F5088CCULL,  -103,  -12 },
+    { 0xD1B71758E219652CULL,   -77,   -4 },
+    { 0x9C40000000000000ULL,   -50,    4 },
+    { 0xE8D4A51000000000ULL,   -24,   12 },
+    { 0xAD78EBC5AC620000ULL,     3,   20 },
+    { 0x813F3978F8940984ULL,    30,   28 },
+    { 0xC097CE7BC90715B3ULL,    56,   36 },
+    { 0x8F7E32CE7BEA5C70ULL,    83,   44 },
+    { 0xD5D238A4ABE98068ULL,   109,   52 },
+    { 0x9F4F2726179A2245ULL,   136,   60 },
+    { 0xED63A231D4C4FB27ULL,   162,   68 },
+    { 0xB0DE65388CC8ADA8ULL,   189,   76 },
+    { 0x83C7088E1AAB65DBULL,   216,   84 },
+    { 0xC45D1DF942711D9AULL,   242,   92 },
+    { 0x924D692CA61BE758ULL,   269,  100 },
+    { 0xDA01EE641A708DEAULL,   295,  108 },
+    { 0xA26DA3999AEF774AULL,   322,  116 },
+    { 0xF209787BB47D6B85ULL,   348,  124 },
+    { 0xB454E4A179DD1877ULL,   375,  132 },
+    { 0x865B86925B9BC5C2ULL,   402,  140 },
+    { 0xC83553C5C8965D3DULL,   428,  148 },
+    { 0x952AB45CFA97A0B3ULL,   455,  156 },
+    { 0xDE469FBD99A05FE3ULL,   481,  164 },
+    { 0xA59BC234DB398C25ULL,   508,  172 },
+    { 0xF6C69A72A3989F5CULL,   534,  180 },
+    { 0xB7DCBF5354E9BECEULL,   561,  188 },
+    { 0x88FCF317F22241E2ULL,   588,  196 },
+    { 0xCC20CE9BD35C78A5ULL,   614,  204 },
+    { 0x98165AF37B2153DFULL,   641,  212 },
+    { 0xE2A0B5DC971F303AULL,   667,  220 },
+    { 0xA8D9D1535CE3B396ULL,   694,  228 },
+    { 0xFB9B7CD9A4A7443CULL,   720,  236 },
+    { 0xBB764C4CA7A44410ULL,   747,  244 },
+    { 0x8BAB8EEFB6409C1AULL,   774,  252 },
+    { 0xD01FEF10A657842CULL,   800,  260 },
+    { 0x9B10A4E5E9913129ULL,   827,  268 },
+    { 0xE7109BFBA19C0C9DULL,   853,  276 },
+    { 0xAC2820D9623BF429ULL,   880,  284 },
+    { 0x80444B5E7AA7CF85ULL,   907,  292 },
+    { 0xBF21E44003ACDD2DULL,   933,  300 },
+    { 0x8E679C2F5E44FF8FULL,   960,  308 },
+    { 0xD433179D9C8CB841ULL,   986,  316 },
+    { 0x9E19DB92B4E31BA9ULL,  1013,  324 },
+};
+
+constexpr std::int32_t CachedPowersMinDecimalExponent = -300;
+constexpr std::int32_t CachedPowersDecimalExponentStep = 8;
+
+/// The binary exponent of the product of the scaled values is kept within [Alpha, Gamma].
+constexpr std::int32_t Alpha = -60;
+constexpr std::int32_t Gamma = -32;
+
+/// Returns c = 10^k such that Alpha <= c.e + e + 64 <= Gamma.
+constexpr CachedPower getCachedPowerForBinaryExponent(const std::int32_t e)
+{
+    // k = ceil((Alpha - e - 1) * log10(2)); 78913 / 2^18 approximates log10(2).
+    const std::int32_t f = Alpha - e - 1;
+    const std::int32_t k = (f * 78913) / (1 << 18) + ((f > 0) ? 1 : 0);
+    const std::int32_t index = (-CachedPowersMinDecimalExponent + k + (CachedPowersDecimalExponentStep - 1)) /
+                               CachedPowersDecimalExponentStep;
+    assert((index >= 0) && (std::size_t(index) < (sizeof(CachedPowers) / sizeof(CachedPowers[0]))));
+    const CachedPower cached = CachedPowers[index];
+    assert((Alpha <= cached.e + e + 64) && (Gamma >= cached.e + e + 64));
+    return cached;
+}
+
+/// For n != 0, returns the number of decimal digits k in n and sets pow10 = 10^(k-1).
+constexpr std::int32_t findLargestPow10(const std::uint32_t n, std::uint32_t& pow10)
+{
+    std::uint32_t p = 1000000000U;
+    std::int32_t k = 10;
+    while (p > n)
+    {
+        p /= 10U;
+        k--;
+    }
+    pow10 = p;
+    return k;
+}
+
+constexpr void round(char* const buffer, const std::int32_t length, const std::uint64_t dist,
+                     const std::uint64_t delta, std::uint64_t rest, const std::uint64_t ten_k)
+{
+    // Move the last digit towards the exact value while staying within the rounding interval.
+    while ((rest < dist) && ((delta - rest) >= ten_k) &&
+           (((rest + ten_k) < dist) || ((dist - rest) > (rest + ten_k - dist))))
+    {
+        assert(buffer[length - 1] != '0');
+        buffer[length - 1]--;
+        rest += ten_k;
+    }
+}
+
+/// Generates the shortest digit sequence within (M-, M+) as close as possible to w.
+constexpr void generateDigits(char* const buffer, std::int32_t& length, std::int32_t& decimal_exponent,
+                              const DiyFP& M_minus, const DiyFP& w, const DiyFP& M_plus)
+{
+    static_assert(Alpha >= -60, "Internal error");
+    static_assert(Gamma <= -32, "Internal error");
+    assert((M_plus.e >= Alpha) && (M_plus.e <= Gamma));
+
+    std::uint64_t delta = DiyFP::subtract(M_plus, M_minus).f;
+    std::uint64_t dist  = DiyFP::subtract(M_plus, w).f;
+
+    const DiyFP one(std::uint64_t(1) << std::uint32_t(-M_plus.e), M_plus.e);
+
+    auto p1 = std::uint32_t(M_plus.f >> std::uint32_t(-one.e));     // Integral part, fits into 32 bits
+    std::uint64_t p2 = M_plus.f & (one.f - 1U);                     // Fractional part
+
+    // Integral digits
+    std::uint32_t pow10 = 0;
+    std::int32_t n = findLargestPow10(p1, pow10);
+    while (n > 0)
+    {
+        const std::uint32_t d = p1 / pow10;
+        p1 %= pow10;
+        buffer[length++] = char('0' + d);
+        n--;
+
+        const std::uint64_t rest = (std::uint64_t(p1) << std::uint32_t(-one.e)) + p2;
+        if (rest <= delta)
+        {
+            decimal_exponent += n;
+            round(buffer, length, dist, delta, rest, std::uint64_t(pow10) << std::uint32_t(-one.e));
+            return;
+        }
+        pow10 /= 10U;
+    }
+
+    // Fractional digits
+    std::int32_t m = 0;
+    while (true)
+    {
+        assert(p2 <= 0xFFFFFFFFFFFFFFFFULL / 10U);
+        p2 *= 10U;
+        delta *= 10U;
+        dist *= 10U;
+        buffer[length++] = char('0' + (p2 >> std::uint32_t(-one.e)));
+        p2 &= one.f - 1U;
+        m++;
+        if (p2 <= delta)
+        {
+            break;
+        }
+    }
+    decimal_exponent -= m;
+    round(buffer, length, dist, delta, p2, one.f);
+}
+
+/**
+ * Writes the shortest decimal digits of the finite positive value into the buffer (at least 17 chars).
+ * The value equals digits * 10^decimal_exponent. Returns the number of digits.
+ */
+template <typename F>
+inline std::int32_t convert(char* const buffer, std::int32_t& decimal_exponent, const F value)
+{
+    const Boundaries b = computeBoundaries(value);
+    assert((b.plus.e == b.minus.e) && (b.plus.e == b.w.e));
+
+    const CachedPower cached = getCachedPowerForBinaryExponent(b.plus.e);
+    const DiyFP c_minus_k(cached.f, cached.e);
+
+    const DiyFP w       = DiyFP::multiply(b.w,     c_minus_k);
+    const DiyFP w_minus = DiyFP::multiply(b.minus, c_minus_k);
+    const DiyFP w_plus  = DiyFP::multiply(b.plus,  c_minus_k);
+
+    // The products may be off by one ulp, so the interval is narrowed conservatively.
+    const DiyFP M_minus(w_minus.f + 1U, w_minus.e);
+    const DiyFP M_plus (w_plus.f  - 1U, w_plus.e);
+
+    std::int32_t length = 0;
+    decimal_exponent = -cached.k;
+    generateDigits(buffer, length, decimal_exponent, M_minus, w, M_plus);
+    return length;
+}
+
+}   // namespace grisu
+
+/// Rounds the decimal digits half-up so that only the specified number of them is kept (may be zero).
+/// Returns true if the carry propagated out of the first digit, e.g., 999 --> 1000.
+constexpr bool roundDecimalDigits(char* const digits, std::int32_t& length, const std::int32_t keep)
+{
+    if (keep >= length)
+    {
+        return false;
+    }
+    const bool round_up = (keep >= 0) && (digits[keep] >= '5');
+    length = std::max<std::int32_t>(keep, 0);
+    if (round_up)
+    {
+        for (std::int32_t i = length - 1; i >= 0; i--)
+        {
+            if (digits[i] != '9')
+            {
+                digits[i]++;
+                return false;
+            }
+            digits[i] = '0';
+        }
+        // All digits were nines (or there were none): the result is 1 followed by zeros.
+        digits[0] = '1';
+        if (length == 0)
+        {
+            length = 1;
+        }
+        return true;
+    }
+    return false;
+}
+
+}
+
+/**
+ * Converts float or double to string and returns it by value, using the same fixed-storage container
+ * as convertIntToString(). No dynamic memory, no libc, no locale, no floating point arithmetic are involved.
+ *
+ * In the default mode (negative Precision), the shortest representation that round-trips is produced,
+ * in the decimal notation if the exponent is small, otherwise in the scientific notation:
+ *      convertFloatToString(0.1)           --> "0.1"
+ *      convertFloatToString(100.0F)        --> "100"
+ *      convertFloatToString(-1.5e-7)       --> "-1.5e-7"
+ *      convertFloatToString(1e300)         --> "1e+300"
+ *
+ * If Precision is non-negative, the decimal notation with that many fractional digits is produced, like "%.Nf",
+ * unless the value is too large for the fixed capacity (>= 1e17 for double, >= 1e9 for float), in which case
+ * the scientific notation with the same number of fractional digits is used instead, like "%.Ne":
+ *      convertFloatToString<3>(3.14159)    --> "3.142"
+ *      convertFloatToString<0>(-2.5)       --> "-3"
+ *      convertFloatToString<2>(1e300)      --> "1.00e+300"
+ * The rounding is performed half-up on the shortest round-trip digits, so that exact decimal ties are rounded the
+ * way one would expect from the printed value (0.125 --> "0.13"), which may differ from printf() in the last digit.
+ *
+ * Non-finite values are represented as "nan", "inf", and "-inf".
+ */
+template <
+    std::int8_t Precision = -1,
+    typename T,
+    typename = std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>>>
+inline auto convertFloatToString(const T number)
+{
+    static_assert(Precision <= 20, "Precision is too large");
+
+    constexpr std::int32_t MaxDigits = std::numeric_limits<T>::max_digits10;     // 9 for float, 17 for double
+    constexpr std::int32_t MaxExponentDigits = (std::numeric_limits<T>::max_exponent10 >= 100) ? 3 : 2;
+    constexpr std::int32_t MaxIntegralDigits = MaxDigits;   // Beyond that, the scientific notation is used
+    constexpr std::int32_t MinDecimalExponent = -4;         // Below that, ditto (shortest mode only)
+    constexpr std::int32_t ExponentChars = 2 + MaxExponentDigits;
+
+    constexpr std::int32_t P = (Precision < 0) ? 0 : Precision;
+    constexpr std::int32_t MaxChars = 1 + ((Precision < 0) ?
+        std::max(2 - MinDecimalExponent + MaxDigits, MaxDigits + 1 + ExponentChars) :
+        std::max(MaxIntegralDigits + 1 + 1 + P, 1 + 1 + P + ExponentChars));
+
+    class Container
+    {
+        std::uint8_t length_ = 0;
+        char storage_[std::size_t(MaxChars) + 1U]{};   // Plus 1 because of zero termination.
+
+        void put(const char c)
+        {
+            assert(length_ < MaxChars);
+            storage_[length_++] = c;
+        }
+
+        void put(const char* s)
+        {
+            while (*s != '\0')
+            {
+                put(*s++);
+            }
+        }
+
+        void putZeros(std::int32_t count)
+        {
+            while (count-- > 0)
+            {
+                put('0');
+            }
+        }
+
+        void putDigits(const char* const digits, const std::int32_t count)
+        {
+            for (std::int32_t i = 0; i < count; i++)
+            {
+                put(digits[i]);
+            }
+        }
+
+        void putExponent(const std::int32_t exponent)
+        {
+            put('e');
+            put((exponent < 0) ? '-' : '+');
+            put(convertIntToString(std::uint16_t((exponent < 0) ? -exponent : exponent)).c_str());
+        }
+
+        /// d1.d2d3...dk e(n-1), where the number of fractional digits is at least min_fractional_digits.
+        void putScientific(const char* const digits, const std::int32_t k, const std::int32_t n,
+                           const std::int32_t min_fractional_digits)
+        {
+            put(digits[0]);
+            const std::int32_t fractional = std::max(k - 1, min_fractional_digits);
+            if (fractional > 0)
+            {
+                put('.');
+                putDigits(&digits[1], k - 1);
+                putZeros(fractional - (k - 1));
+            }
+            putExponent(n - 1);
+        }
+
+        void putShortest(const char* const digits, const std::int32_t k, const std::int32_t n)
+        {
+            if ((n > 0) && (n <= MaxIntegralDigits))
+            {
+                if (k <= n)
+                {
+                    putDigits(digits, k);          // 123 or 1230
+                    putZeros(n - k);
+                }
+                else
+                {
+                    putDigits(digits, n);          // 12.3
+                    put('.');
+                    putDigits(&digits[n], k - n);
+                }
+            }
+            else if ((n <= 0) && (n > MinDecimalExponent))
+            {
+                put("0.");                          // 0.0123
+                putZeros(-n);
+                putDigits(digits, k);
+            }
+            else
+            {
+                putScientific(digits, k, n, 0);     // 1.23e+45
+            }
+        }
+
+        void putFixed(char* const digits, std::int32_t k, std::int32_t n)
+        {
+            if (n > MaxIntegralDigits)
+            {
+                if (detail::roundDecimalDigits(digits, k, 1 + P))
+                {
+                    n++;
+                }
+                putScientific(digits, k, n, P);
+                return;
+            }
+
+            if (detail::roundDecimalDigits(digits, k, n + P))
+            {
+                n++;        // E.g., 0.96 --> 1 or 0.0006 --> 0.001
+            }
+
+            // Integral part
+            if (n > 0)
+            {
+                const std::int32_t integral = std::min(k, n);
+                putDigits(digits, integral);
+                putZeros(n - integral);
+            }
+            else
+            {
+                put('0');
+            }
+
+            // Fractional part: -n leading zeros, then what remains of the digits
+            if (P > 0)
+            {
+                put('.');
+                std::int32_t written = 0;
+                for (std::int32_t pos = n; (pos < k) && (written < P); pos++, written++)
+                {
+                    put((pos < 0) ? '0' : digits[pos]);
+                }
+                putZeros(P - written);
+            }
+        }
+
+    public:
+        explicit Container(const T x)
+        {
+            // The classification is done on the bit representation to avoid floating point operations.
+            using Bits = std::conditional_t<(sizeof(T) == sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+            constexpr Bits SignMask = Bits(Bits(1) << ((sizeof(Bits) * 8U) - 1U));
+            const T infinity = std::numeric_limits<T>::infinity();
+            Bits infinity_bits = 0;
+            std::memcpy(&infinity_bits, &infinity, sizeof(infinity_bits));
+            Bits bits = 0;
+            std::memcpy(&bits, &x, sizeof(bits));
+
+            const Bits magnitude_bits = Bits(bits & Bits(~SignMask));
+            if (magnitude_bits > infinity_bits)
+            {
+                put("nan");
+                return;
+            }
+            if ((bits & SignMask) != 0)
+            {
+                put('-');
+            }
+            if (magnitude_bits == infinity_bits)
+            {
+                put("inf");
+                return;
+            }
+            T magnitude{};
+            std::memcpy(&magnitude, &magnitude_bits, sizeof(magnitude));
+
+            char digits[std::size_t(MaxDigits) + 1U]{};
+            std::int32_t k = 1;
+            std::int32_t n = 1;
+            if (magnitude_bits != 0)
+            {
+                std::int32_t decimal_exponent = 0;
+                k = detail::grisu::convert(&digits[0], decimal_exponent, magnitude);
+                n = k + decimal_exponent;      // Position of the decimal point relative to the first digit
+            }
+            else
+            {
+                digits[0] = '0';
+            }
+
+            if constexpr (Precision < 0)
+            {
+                putShortest(&digits[0], k, n);
+            }
+            else
+            {
+                putFixed(&digits[0], k, n);
+            }
+        }
+
+        const char* c_str() const { return &storage_[0]; }
+
+        operator const char* () const { return this->c_str(); }
+
+        std::uint16_t length() const { return length_; }
+        std::uint16_t size() const { return length(); }
+
+        constexpr std::uint16_t capacity() const { return MaxChars; }
+        constexpr std::uint16_t max_size() const { return MaxChars; }
+    };
+
+    return Container(number);
+}
+
+/**
+ * Outcome of parseInt() and parseFloat().
+ */
+enum class ParseError : std::uint8_t
+{
+    None,
+    Empty,          ///< The input is empty.
+    Malformed,      ///< The input is not a number or has extra characters in it.
+    Overflow,       ///< The number is out of range of the type; the value is saturated (or infinite for floats).
+};
+
+template <typename T>
+struct ParseResult
+{
+    T value{};
+    ParseError error = ParseError::None;
+
+    [[nodiscard]] constexpr explicit operator bool() const { return error == ParseError::None; }
+};
+
+namespace detail
+{
+/// Returns Radix if the character is not a valid digit.
+template <std::uint8_t Radix>
+constexpr std::uint8_t parseDigit(const char c)
+{
+    std::uint8_t d = Radix;
+    if ((c >= '0') && (c <= '9'))
+    {
+        d = std::uint8_t(c - '0');
+    }
+    else if ((c >= 'a') && (c <= 'z'))
+    {
+        d = std::uint8_t(c - 'a' + 10);
+    }
+    else if ((c >= 'A') && (c <= 'Z'))
+    {
+        d = std::uint8_t(c - 'A' + 10);
+    }
+    return (d < Radix) ? d : Radix;
+}
+
+/// The number of digits that can be accumulated in the type without the risk of overflow.
+template <typename T, std::uint8_t Radix>
+constexpr std::size_t getSafeDigitCount()
+{
+    std::size_t n = 0;
+    T p = 1;
+    while (p <= (std::numeric_limits<T>::max() / Radix))
+    {
+        p = T(p * Radix);
+        n++;
+    }
+    return n;
+}
+
+/// Consumes the sign character, if any. Returns true if the number is negative.
+constexpr bool parseSign(StringView& s)
+{
+    if (s.starts_with('-'))
+    {
+        s.remove_prefix(1);
+        return true;
+    }
+    if (s.starts_with('+'))
+    {
+        s.remove_prefix(1);
+    }
+    return false;
+}
+
+/// 10^0 ... 10^22 are exactly representable in double, 10^0 ... 10^10 in float.
+inline constexpr double ExactPowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+/**
+ * Computes mantissa * 10^exponent rounded to the nearest value of F, or infinity on overflow.
+ * The scaling is done in 64-bit fixed point using the cached powers of Grisu, so the result is exact
+ * unless the value is extremely close to a halfway point between two adjacent floats.
+ */
+template <typename F>
+inline F scaleDecimal(const std::uint64_t mantissa, std::int32_t exponent)
+{
+    using grisu::DiyFP;
+    using grisu::CachedPowers;
+    using Bits = std::conditional_t<(sizeof(F) == sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+
+    constexpr std::int32_t Precision = std::numeric_limits<F>::digits;
+    constexpr std::int32_t Bias = std::numeric_limits<F>::max_exponent - 1;
+    constexpr std::int32_t MinDecimalExponent = std::numeric_limits<F>::min_exponent10 -
+                                                std::numeric_limits<F>::digits10 - 25;  // Always zero below that
+    constexpr std::int32_t MaxDecimalExponent = std::numeric_limits<F>::max_exponent10 + 1; // Always inf above
+
+    Bits bits = 0;
+    F infinity = std::numeric_limits<F>::infinity();
+    Bits infinity_bits = 0;
+    std::memcpy(&infinity_bits, &infinity, sizeof(infinity_bits));
+
+    if ((mantissa == 0) || (exponent < MinDecimalExponent))
+    {
+        bits = 0;
+    }
+    else if (exponent > MaxDecimalExponent)
+    {
+        bits = infinity_bits;
+    }
+    else
+    {
+        DiyFP v = DiyFP::normalize(DiyFP(mantissa, 0));
+        if (exponent < grisu::CachedPowersMinDecimalExponent)
+        {
+            v = DiyFP::normalize(DiyFP::multiply(v, DiyFP(CachedPowers[0].f, CachedPowers[0].e)));
+            exponent -= grisu::CachedPowersMinDecimalExponent;
+        }
+        const std::int32_t index = (exponent - grisu::CachedPowersMinDecimalExponent) /
+                                   grisu::CachedPowersDecimalExponentStep;
+        const grisu::CachedPower& cached = CachedPowers[index];
+        v = DiyFP::normalize(DiyFP::multiply(v, DiyFP(cached.f, cached.e)));
+        const std::int32_t remainder = exponent - cached.k;
+        assert((remainder >= 0) && (remainder < grisu::CachedPowersDecimalExponentStep));
+        if (remainder > 0)
+        {
+            std::uint64_t p = 1;
+            for (std::int32_t i = 0; i < remainder; i++)
+            {
+                p *= 10U;
+            }
+            v = DiyFP::normalize(DiyFP::multiply(v, DiyFP::normalize(DiyFP(p, 0))));
+        }
+
+        // v = f * 2^e, where the MSB of f is set. Drop the excess bits rounding half to even.
+        std::int32_t biased_exponent = v.e + 63 + Bias;
+        std::int32_t shift = 64 - Precision;
+        if (biased_exponent <= 0)   // Subnormal
+        {
+            shift += 1 - biased_exponent;
+            biased_exponent = 0;
+        }
+        if (shift > 64)
+        {
+            bits = 0;
+        }
+        else
+        {
+            const std::uint64_t kept = (shift >= 64) ? 0 : (v.f >> std::uint32_t(shift));
+            const std::uint64_t rest = (shift >= 64) ? v.f : (v.f & ((std::uint64_t(1) << std::uint32_t(shift)) - 1U));
+            const std::uint64_t half = std::uint64_t(1) << std::uint32_t(shift - 1);
+            std::uint64_t m = kept;
+            if ((rest > half) || ((rest == half) && ((kept & 1U) != 0)))
+            {
+                m++;        // A carry into the exponent field is handled naturally by the addition below
+            }
+            const std::uint64_t composed =
+                (biased_exponent > 0) ? ((std::uint64_t(biased_exponent - 1) << std::uint32_t(Precision - 1)) + m) : m;
+            bits = (composed >= infinity_bits) ? infinity_bits : Bits(composed);
+        }
+    }
+
+    F out{};
+    std::memcpy(&out, &bits, sizeof(out));
+    return out;
+}
+
+}
+
+/**
+ * Parses an integer of the specified type in the specified radix from the whole string, e.g.:
+ *      parseInt<std::int32_t>("-123")
+ *      parseInt<std::uint16_t, 16>(token)
+ * This is the inverse of convertIntToString(). The locale, errno, and exceptions are not used.
+ * An optional sign is accepted (minus only for signed types); whitespace and radix prefixes are not.
+ * Letter digits are case-insensitive.
+ * On overflow, the value is saturated and the error is reported.
+ */
+template <
+    typename T,
+    std::uint8_t Radix = 10,
+    typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+[[nodiscard]]
+inline constexpr ParseResult<T> parseInt(StringView s)
+{
+    static_assert(Radix >= 2, "Radix must be at least 2");
+    static_assert(Radix <= 36, "Radix is too large");
+
+    using Unsigned = std::make_unsigned_t<T>;
+    using Word = std::conditional_t<(sizeof(Unsigned) <= sizeof(std::uint32_t)), std::uint32_t, Unsigned>;
+
+    ParseResult<T> out;
+    if (s.empty())
+    {
+        out.error = ParseError::Empty;
+        return out;
+    }
+
+    const bool negative = detail::parseSign(s);
+    if (s.empty() || (negative && !std::is_signed_v<T>))
+    {
+        out.error = ParseError::Malformed;
+        return out;
+    }
+
+    // The magnitude limit is computed in unsigned arithmetic, which is well-defined for the most negative value.
+    const Word limit = negative ? Word(Unsigned(Unsigned(0U) - Unsigned(std::numeric_limits<T>::min())))
+                                : Word(std::numeric_limits<T>::max());
+    const Word cutoff = Word(limit / Radix);
+    const Word cutoff_digit = Word(limit % Radix);
+
+    // The first digits can't overflow the word, so they are accumulated without the range checks.
+    constexpr std::size_t SafeDigits = detail::getSafeDigitCount<Word, Radix>();
+    std::size_t i = 0;
+    Word acc = 0;
+    const std::size_t fast = (s.size() < SafeDigits) ? s.size() : SafeDigits;
+    for (; i < fast; i++)
+    {
+        const std::uint8_t d = detail::parseDigit<Radix>(s[i]);
+        if (d >= Radix)
+        {
+            out.error = ParseError::Malformed;
+            return out;
+        }
+        acc = Word(acc * Radix + d);
+    }
+
+    bool overflow = acc > limit;
+    for (; i < s.size(); i++)
+    {
+        const std::uint8_t d = detail::parseDigit<Radix>(s[i]);
+        if (d >= Radix)
+        {
+            out.error = ParseError::Malformed;
+            return out;
+        }
+        if (overflow || (acc > cutoff) || ((acc == cutoff) && (d > cutoff_digit)))
+        {
+            overflow = true;    // Keep going to validate the rest of the input
+        }
+        else
+        {
+            acc = Word(acc * Radix + d);
+        }
+    }
+
+    if (overflow)
+    {
+        out.error = ParseError::Overflow;
+        out.value = negative ? std::numeric_limits<T>::min() : std::numeric_limits<T>::max();
+    }
+    else
+    {
+        out.value = negative ? T(Unsigned(Unsigned(0U) - Unsigned(acc))) : T(acc);
+    }
+    return out;
+}
+
+/**
+ * Parses a float or double in the decimal or scientific notation from the whole string, e.g.:
+ *      parseFloat<float>("-1.25e-3")
+ * This is the inverse of convertFloatToString(). The locale, errno, dynamic memory, and exceptions are not used.
+ * Also accepted are "inf", "infinity", and "nan" (case-insensitive), with an optional sign.
+ *
+ * Short inputs (at most 15 significant digits and a small exponent; 7 digits for float) are converted with one
+ * exact floating point operation, so the result is correctly rounded. Longer inputs are scaled in 64-bit fixed
+ * point, which is correctly rounded except for rare inputs extremely close to a halfway point,
+ * where the result may be off by one ULP.
+ * On overflow, the value is infinite and the error is reported. Underflow silently yields zero.
+ */
+template <typename T, typename = std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>>>
+[[nodiscard]]
+inline ParseResult<T> parseFloat(StringView s)
+{
+    ParseResult<T> out;
+    if (s.empty())
+    {
+        out.error = ParseError::Empty;
+        return out;
+    }
+
+    const bool negative = detail::parseSign(s);
+
+    if (s.equalsIgnoreCase("inf") || s.equalsIgnoreCase("infinity"))
+    {
+        out.value = negative ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity();
+        return out;
+    }
+    if (s.equalsIgnoreCase("nan"))
+    {
+        out.value = std::numeric_limits<T>::quiet_NaN();
+        return out;
+    }
+
+    // Up to 19 significant digits are accumulated; the rest only affect the exponent.
+    constexpr std::size_t MaxMantissaDigits = 19;
+    std::uint64_t mantissa = 0;
+    std::size_t significant_digits = 0;
+    std::int32_t exponent = 0;
+    bool truncated = false;
+    bool seen_digits = false;
+    bool seen_point = false;
+
+    std::size_t i = 0;
+    for (; i < s.size(); i++)
+    {
+        const char c = s[i];
+        if ((c >= '0') && (c <= '9'))
+        {
+            seen_digits = true;
+            if ((mantissa == 0) && (c == '0'))
+            {
+                exponent -= seen_point ? 1 : 0;         // Leading zeros are not significant
+            }
+            else if (significant_digits < MaxMantissaDigits)
+            {
+                mantissa = mantissa * 10U + std::uint64_t(c - '0');
+                significant_digits++;
+                exponent -= seen_point ? 1 : 0;
+            }
+            else
+            {
+                truncated = truncated || (c != '0');
+                exponent += seen_point ? 0 : 1;
+            }
+        }
+        else if ((c == '.') && !seen_point)
+        {
+            seen_point = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    if (!seen_digits)
+    {
+        out.error = ParseError::Malformed;
+        return out;
+    }
+
+    if ((i < s.size()) && ((s[i] == 'e') || (s[i] == 'E')))
+    {
+        StringView e = s.substr(i + 1U);
+        const bool negative_exponent = detail::parseSign(e);
+        if (e.empty())
+        {
+            out.error = ParseError::Malformed;
+            return out;
+        }
+        std::int32_t explicit_exponent = 0;
+        for (const char c : e)
+        {
+            if ((c < '0') || (c > '9'))
+            {
+                out.error = ParseError::Malformed;
+                return out;
+            }
+            if (explicit_exponent < 100000)    // Saturate; anything beyond that is zero or infinity anyway
+            {
+                explicit_exponent = explicit_exponent * 10 + (c - '0');
+            }
+        }
+        exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+        i = s.size();
+    }
+
+    if (i < s.size())
+    {
+        out.error = ParseError::Malformed;
+        return out;
+    }
+
+    // Fast path: both the mantissa and the power of ten are exact, so one operation yields a correctly rounded result
+    constexpr std::uint64_t MaxExactMantissa = std::uint64_t(1) << std::uint32_t(std::numeric_limits<T>::digits);
+    constexpr std::int32_t MaxExactExponent = std::is_same_v<T, float> ? 10 : 22;
+    T value{};
+    if (!truncated && (mantissa <= MaxExactMantissa) && (exponent >= -MaxExactExponent) &&
+        (exponent <= MaxExactExponent))
+    {
+        value = T(mantissa);
+        if (exponent < 0)
+        {
+            value /= T(detail::ExactPowersOf10[-exponent]);
+        }
+        else
+        {
+            value *= T(detail::ExactPowersOf10[exponent]);
+        }
+    }
+    else
+    {
+        value = detail::scaleDecimal<T>(mantissa, exponent);
+    }
+
+    if (value > std::numeric_limits<T>::max())
+    {
+        out.error = ParseError::Overflow;
+    }
+    out.value = negative ? -value : value;
+    return out;
+}
+
+template <std::size_t Capacity_, typename OverflowPolicy_ = overflow::Truncate>
+class String;
+
+template <typename Left, typename Right>
+class Concatenation;
+
+/**
+ * A non-owning reference to a String<> of any capacity.
+ * Code that accepts StringRef is compiled once for all capacities, unlike a template over String<Capacity>;
+ * the bulk operations of String<> are implemented here for the same reason. The semantics are those of String<>:
+ * the content is always null-terminated, and whatever does not fit is truncated.
+ * A read-only string is better passed as StringView.
+ */
+class StringRef
+{
+    char* buf_;
+    std::size_t capacity_;
+    detail::LengthRef len_;
+
+public:
+    /// The buffer shall hold capacity + 1 chars; the length type shall be one of SmallestUnsignedFor<>.
+    template <typename L>
+    constexpr StringRef(char* const buffer, const std::size_t capacity, L* const length) :
+        buf_(buffer),
+        capacity_(capacity),
+        len_(length)
+    {
+        assert(*length <= capacity);
+    }
+
+    template <std::size_t C, typename P>
+    constexpr StringRef(String<C, P>& s) :  // NOLINT implicit by design
+        StringRef(&s.buf_[0], C, &s.len_)
+    { }
+
+    [[nodiscard]] constexpr std::size_t capacity() const { return capacity_; }
+    [[nodiscard]] constexpr std::size_t max_size() const { return capacity_; }
+
+    [[nodiscard]] constexpr std::size_t size()   const { return len_.get(); }
+    [[nodiscard]] constexpr std::size_t length() const { return len_.get(); }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    constexpr bool empty() const { return size() == 0; }
+
+    [[nodiscard]] constexpr const char* c_str() const { return buf_; }
+    [[nodiscard]] constexpr char*       data()  const { return buf_; }
+
+    [[nodiscard]] constexpr const char* begin() const { return buf_; }
+    [[nodiscard]] constexpr const char* end()   const { return buf_ + size(); }
+
+    [[nodiscard]] constexpr StringView view() const { return StringView(buf_, size()); }
+
+    constexpr operator StringView() const { return view(); }    // NOLINT implicit by design
+
+    [[nodiscard]]
+    constexpr char& operator[](const std::size_t index) const
+    {
+        assert(index < size());
+        return buf_[index];
+    }
+
+    constexpr void clear() const { setLength(0); }
+
+    /// Unlike String<>::resize(), the size is clamped to the capacity.
+    constexpr void resize(const std::size_t sz, const char c = char()) const
+    {
+        const std::size_t len = size();
+        const std::size_t new_length = std::min(sz, capacity_);
+        for (std::size_t i = len; i < new_length; i++)
+        {
+            buf_[i] = c;
+        }
+        setLength(new_length);
+    }
+
+    constexpr void push_back(const char c) const
+    {
+        const std::size_t len = size();
+        if (len < capacity_)
+        {
+            buf_[len] = c;
+            setLength(len + 1U);
+        }
+    }
+
+    constexpr void pop_back() const
+    {
+        const std::size_t len = size();
+        if (len > 0)
+        {
+            setLength(len - 1U);
+        }
+    }
 
-                if constexpr (std::is_signed<T>::value)
-                {
-                    // We can't just do "x = -x", because it would break on int8_t(-128), int16_t(-32768), etc.
-                    std::int8_t residual = std::int8_t(x % Radix);
-                    if (residual < 0)
-                    {
-                        // Should never happen - since C++11, neg % pos --> pos
-                        residual = std::int8_t(-residual);
-                    }
+    constexpr const StringRef& append(const char* const p, const std::size_t length) const
+    {
+        const std::size_t len = size();
+        const std::size_t n = std::min(length, capacity_ - len);
+        detail::copyChars(buf_ + len, p, n);
+        setLength(len + n);
+        return *this;
+    }
 
-                    storage_[--offset_] = Alphabet[residual];
+    constexpr const StringRef& append(const char* const p) const
+    {
+        return append(p, detail::getBoundedLength(p, capacity_ - size()));
+    }
 
-                    // Signed integers are really tricky sometimes.
-                    // We must not mix negative with positive to avoid implementation-defined behaviors.
-                    x = T((x < 0) ? -(x / -Radix) : (x / Radix));
-                }
-                else
-                {
-                    // Fast branch for unsigned arguments.
-                    storage_[--offset_] = Alphabet[x % Radix];
-                    x = T(x / Radix);
-                }
-            }
-            while (x != 0);
+    /// See String<>::append().
+    template <typename T, typename = std::enable_if_t<detail::IsCharSequence<T>::value>>
+    constexpr const StringRef& append(const T& s) const
+    {
+        if constexpr (detail::HasDataAndSize<T>::value)
+        {
+            return append(s.data(), std::size_t(s.size()));
+        }
+        else if constexpr (detail::HasCStrAndSize<T>::value)
+        {
+            return append(s.c_str(), std::size_t(s.size()));
+        }
+        else
+        {
+            return append(s.c_str());
+        }
+    }
 
-            if (negative)
-            {
-                assert(offset_ > 0);
-                storage_[--offset_] = '-';
-            }
+    template <typename T>
+    constexpr const StringRef& operator+=(const T& s) const { return append(s); }
 
-            assert(offset_ < MaxChars);                 // Making sure there was no overflow.
-        }
+    constexpr const StringRef& operator+=(const char c) const
+    {
+        push_back(c);
+        return *this;
+    }
 
-        const char* c_str() const { return &storage_[offset_]; }
+    template <typename T>
+    [[nodiscard]]
+    constexpr bool operator==(const T& s) const { return view() == StringView(s); }
 
-        operator const char* () const { return this->c_str(); }
+    template <typename T>
+    [[nodiscard]]
+    constexpr bool operator!=(const T& s) const { return !operator==(s); }
 
-        std::uint16_t length() const { return std::uint16_t(MaxChars - offset_); }
-        std::uint16_t size() const { return length(); }
+    /// The length is clamped to the capacity, which is redundant, but it lets the compiler see the bounds
+    /// (and drop the vectorized path) when the capacity is known at the call site.
+    constexpr void makeLowerCase() const { detail::convertCase<false>(buf_, buf_, std::min(size(), capacity_)); }
+    constexpr void makeUpperCase() const { detail::convertCase<true>(buf_, buf_, std::min(size(), capacity_)); }
 
-        constexpr std::uint16_t capacity() const { return MaxChars; }
-        constexpr std::uint16_t max_size() const { return MaxChars; }
-    };
+    [[nodiscard]]
+    constexpr bool equalsIgnoreCase(const StringView other) const { return view().equalsIgnoreCase(other); }
 
-    return Container(number);
-}
+private:
+    constexpr void setLength(const std::size_t new_length) const
+    {
+        len_.set(new_length);
+        buf_[new_length] = '\0';
+    }
+};
 
 /**
  * A string with fixed storage, API like std::string.
+ * The entire API can be used in constant expressions, so that constant strings and tables thereof
+ * can be built at compile time and placed into ROM.
+ * The overflow policy defines what happens when the data does not fit; by default, the excess is truncated.
+ * See senoval::overflow.
  */
-template <std::size_t Capacity_>
-class String
+template <std::size_t Capacity_, typename OverflowPolicy_>
+class String : private OverflowPolicy_, private detail::Instrumented<String<Capacity_, OverflowPolicy_>>
 {
 public:
     static constexpr std::size_t Capacity = Capacity_;
+    using OverflowPolicy = OverflowPolicy_;
 
     static_assert(Capacity > 0, "Capacity must be positive");
 
 private:
-    template <std::size_t C>
+    template <std::size_t C, typename P>
     friend class String;
 
-    std::size_t len_ = 0;
-    char buf_[Capacity + 1];
+    friend class StringRef;
+
+    // The length goes after the buffer so that a narrow length type does not introduce padding.
+    char buf_[Capacity + 1]{};      // Zero-initialized to make the class usable in constant expressions
+    detail::SmallestUnsignedFor<Capacity> len_ = 0;
 
 public:
-    String() // NOLINT
+    constexpr String() // NOLINT
     {
         buf_[len_] = '\0';
     }
 
     /// Implicit on purpose
-    String(const char* const initializer) // NOLINT
+    constexpr String(const char* const initializer) // NOLINT
     {
         (*this) += initializer;
     }
 
     template <typename InputIterator>
-    String(InputIterator begin, const InputIterator end) // NOLINT
+    constexpr String(InputIterator begin, const InputIterator end) // NOLINT
     {
-        while ((begin != end) && (len_ < Capacity))
+        if constexpr (std::is_pointer_v<InputIterator> &&
+                      std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIterator>>, char>)
         {
-            buf_[len_] = static_cast<char>(*begin);
-            ++len_;
-            ++begin;
+            append(begin, std::size_t(end - begin));    // Contiguous range, the length is known in advance
+        }
+        else
+        {
+            while ((begin != end) && (len_ < Capacity))
+            {
+                buf_[len_] = static_cast<char>(*begin);
+                ++len_;
+                ++begin;
+            }
+            buf_[len_] = '\0';
+            this->noteSize(len_);
+            if (begin != end)
+            {
+                reportOverflow(OverflowKind::Truncation);
+            }
         }
-        buf_[len_] = '\0';
     }
 
-    template <std::size_t C>
-    String(const String<C>& initializer) // NOLINT
+    template <std::size_t C, typename P>
+    constexpr String(const String<C, P>& initializer) // NOLINT
     {
-        (*this) += initializer;
+        append(initializer.data(), initializer.size());
+    }
+
+    constexpr String(const StringView initializer) // NOLINT
+    {
+        append(initializer.data(), initializer.size());
+    }
+
+    /// The operands of the concatenation are written directly into the new string.
+    template <typename L, typename R>
+    constexpr String(const Concatenation<L, R>& initializer) // NOLINT
+    {
+        buf_[len_] = '\0';
+        initializer.appendTo(*this);
     }
 
     /*
@@ -197,44 +1547,64 @@ public:
     [[nodiscard]] constexpr std::size_t capacity() const { return Capacity; }
     [[nodiscard]] constexpr std::size_t max_size() const { return Capacity; }
 
-    [[nodiscard]] std::size_t size()   const { return len_; }
-    [[nodiscard]] std::size_t length() const { return len_; }
+    [[nodiscard]] constexpr std::size_t size()   const { return len_; }
+    [[nodiscard]] constexpr std::size_t length() const { return len_; }
 
     [[nodiscard]] // nodiscard prevents confusion with clear()
-    bool empty() const { return len_ == 0; }
+    constexpr bool empty() const { return len_ == 0; }
+
+    [[nodiscard]] constexpr const char* c_str() const { return &buf_[0]; }
 
-    [[nodiscard]] const char* c_str() const { return &buf_[0]; }
+    /// Free of charge. The view is invalidated when the string is modified.
+    [[nodiscard]] constexpr StringView view() const { return StringView(&buf_[0], len_); }
 
-    void clear()
+    /// Same as StringView::hash(); see there.
+    [[nodiscard]] constexpr std::uint32_t hash() const { return view().hash(); }
+
+    constexpr operator StringView() const { return view(); }    // NOLINT implicit by design
+
+    constexpr void clear()
     {
         len_ = 0;
         buf_[len_] = '\0';
     }
 
-    void resize(std::size_t sz, char c = char())
+    /// The size is clamped to the capacity.
+    constexpr void resize(std::size_t sz, char c = char())
     {
-        while (len_ < sz)
-        {
-            push_back(c);
-        }
-
-        while (len_ > sz)
+        if (sz > Capacity)
         {
-            pop_back();
+            reportOverflow(OverflowKind::Truncation);
         }
+        StringRef(*this).resize(sz, c);
+        this->noteSize(len_);
     }
 
-    void push_back(char c)
+    constexpr void push_back(char c)
     {
-        if (len_ < Capacity)
+        if constexpr (OverflowPolicy::IsChecked)
+        {
+            if (len_ < Capacity)
+            {
+                buf_[len_] = c;
+                ++len_;
+            }
+            else
+            {
+                reportOverflow(OverflowKind::Capacity);
+            }
+        }
+        else
         {
+            assert(len_ < Capacity);
             buf_[len_] = c;
             ++len_;
         }
         buf_[len_] = '\0';
+        this->noteSize(len_);
     }
 
-    void pop_back()
+    constexpr void pop_back()
     {
         if (len_ > 0)
         {
@@ -243,167 +1613,520 @@ public:
         buf_[len_] = '\0';
     }
 
-    [[nodiscard]] char&       front()       { return operator[](0); }
-    [[nodiscard]] const char& front() const { return operator[](0); }
+    [[nodiscard]] constexpr char&       front()       { return operator[](0); }
+    [[nodiscard]] constexpr const char& front() const { return operator[](0); }
 
     [[nodiscard]]
-    char& back()
+    constexpr char& back()
     {
-        if (len_ > 0)
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            return buf_[len_ - 1U];
+            if (len_ == 0)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return buf_[0];
+            }
         }
-        else
+        assert(len_ > 0);
+        return buf_[len_ - 1U];
+    }
+    [[nodiscard]]
+    constexpr const char& back() const
+    {
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            assert(false);
-            return buf_[0];
+            if (len_ == 0)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return buf_[0];
+            }
         }
+        assert(len_ > 0);
+        return buf_[len_ - 1U];
     }
-    [[nodiscard]] const char& back() const { return const_cast<String*>(this)->back(); }
 
     /*
      * Iterators - only const iterators are provided for safety reasons.
      * It is easy to accidentally bring the object into an invalid state by zeroing a char in the middle.
      */
-    [[nodiscard]] const char* begin() const { return &buf_[0]; }
-    [[nodiscard]] const char* end()   const { return &buf_[len_]; }
+    [[nodiscard]] constexpr const char* begin() const { return &buf_[0]; }
+    [[nodiscard]] constexpr const char* end()   const { return &buf_[len_]; }
+
+    [[nodiscard]] constexpr char*       data()       { return &buf_[0]; }
+    [[nodiscard]] constexpr const char* data() const { return &buf_[0]; }
+
+    /*
+     * Bulk append. The source length is determined once, then the data is copied in one go.
+     * Whatever does not fit into the remaining capacity is truncated and reported to the overflow policy.
+     * The implementation is in StringRef, so that it is shared by all capacities.
+     */
+    constexpr String& append(const char* const p, const std::size_t length)
+    {
+        if (length > (Capacity - len_))
+        {
+            reportOverflow(OverflowKind::Truncation);
+        }
+        (void) StringRef(*this).append(p, length);
+        this->noteSize(len_);
+        return *this;
+    }
+
+    /// The source string is never scanned past the remaining capacity plus one, so it need not even be
+    /// null-terminated if it is long enough.
+    constexpr String& append(const char* const p)
+    {
+        const std::size_t remaining = Capacity - len_;
+        return append(p, detail::getBoundedLength(p, remaining + 1U));
+    }
 
-    [[nodiscard]] char*       data()       { return &buf_[0]; }
-    [[nodiscard]] const char* data() const { return &buf_[0]; }
+    /// Accepts String<>, std::string, std::string_view, and anything else that provides either data()+size()
+    /// or c_str(). The length is taken from size() if available.
+    template <typename T, typename = std::enable_if_t<detail::IsCharSequence<T>::value>>
+    constexpr String& append(const T& s)
+    {
+        if constexpr (detail::HasDataAndSize<T>::value)
+        {
+            return append(s.data(), std::size_t(s.size()));
+        }
+        else if constexpr (detail::HasCStrAndSize<T>::value)
+        {
+            return append(s.c_str(), std::size_t(s.size()));
+        }
+        else
+        {
+            return append(s.c_str());
+        }
+    }
 
     /*
      * Operators
      */
     template <typename T>
-    String& operator=(const T& s)
+    constexpr String& operator=(const T& s)
     {
         clear();
         (*this) += s;
         return *this;
     }
 
-    template <typename T, typename = decltype(std::declval<T>().c_str())>
-    String& operator+=(const T& s)
+    template <typename L, typename R>
+    constexpr String& operator=(const Concatenation<L, R>& s)
     {
-        (*this) += s.c_str();
+        if (s.overlaps(begin(), &buf_[Capacity]))
+        {
+            // Something like "s = '[' + s + ']'"; the operands must be read before the destination is altered.
+            // One extra character in the copy is enough to let the overflow through to the policy of this string.
+            const String<Capacity + 1U> copy(s);
+            clear();
+            append(copy.data(), copy.size());
+        }
+        else
+        {
+            clear();
+            s.appendTo(*this);
+        }
         return *this;
     }
 
-    String& operator+=(const char* p)
+    template <typename L, typename R>
+    constexpr String& operator+=(const Concatenation<L, R>& s)
     {
-        while ((*p != '\0') && (len_ < Capacity))
+        if (s.overlaps(begin(), &buf_[Capacity]))
         {
-            buf_[len_] = *p++;
-            ++len_;
+            const String<Capacity + 1U> copy(s);
+            return append(copy.data(), copy.size());
         }
-        buf_[len_] = '\0';
+        s.appendTo(*this);
         return *this;
     }
 
-    String& operator+=(char c)
+    template <typename T, typename = std::enable_if_t<detail::IsCharSequence<T>::value>>
+    constexpr String& operator+=(const T& s)
+    {
+        return append(s);
+    }
+
+    constexpr String& operator+=(const char* p)
+    {
+        return append(p);
+    }
+
+    constexpr String& operator+=(char c)
     {
         push_back(c);
         return *this;
     }
 
     [[nodiscard]]
-    char& operator[](std::size_t index)
+    constexpr char& operator[](std::size_t index)
     {
-        if (index < len_)
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            return buf_[index];
+            if (index >= len_)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return buf_[(len_ > 0) ? (len_ - 1U) : 0U];
+            }
         }
-        else
+        assert(index < len_);
+        return buf_[index];
+    }
+    [[nodiscard]]
+    constexpr const char& operator[](std::size_t index) const
+    {
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            assert(false);
-            return back();
+            if (index >= len_)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return buf_[(len_ > 0) ? (len_ - 1U) : 0U];
+            }
         }
+        assert(index < len_);
+        return buf_[index];
     }
+
+    template <typename T, typename = decltype(std::declval<T>().begin())>
     [[nodiscard]]
-    const char& operator[](std::size_t index) const
+    constexpr bool operator==(const T& s) const
     {
-        return const_cast<String*>(this)->operator[](index);
+        if constexpr (detail::HasDataAndSize<T>::value)
+        {
+            return (std::size_t(s.size()) == len_) && detail::equalChars(s.data(), &buf_[0], len_);
+        }
+        else if constexpr (detail::HasCStrAndSize<T>::value)
+        {
+            return (std::size_t(s.size()) == len_) && detail::equalChars(s.c_str(), &buf_[0], len_);
+        }
+        // std::equal() is not constexpr until C++20
+        auto it = std::begin(s);
+        const auto end = std::end(s);
+        for (std::size_t i = 0; i < len_; ++i)
+        {
+            if ((it == end) || (*it != buf_[i]))
+            {
+                return false;
+            }
+            ++it;
+        }
+        return it == end;
     }
 
-    template <typename T, typename = decltype(std::declval<T>().begin())>
     [[nodiscard]]
-    bool operator==(const T& s) const
+    constexpr bool operator==(const char* s) const
     {
-        return std::equal(begin(), end(), std::begin(s), std::end(s));
+        // The other string is never scanned past our length, so a long mismatching one is rejected quickly.
+        return (detail::getBoundedLength(s, len_ + 1U) == len_) && detail::equalChars(s, &buf_[0], len_);
     }
 
+    template <typename L, typename R>
     [[nodiscard]]
-    bool operator==(const char* s) const
+    constexpr bool operator==(const Concatenation<L, R>& s) const
     {
-        return 0 == std::strncmp(this->c_str(), s, sizeof(buf_));
+        return operator==(String<Concatenation<L, R>::Capacity>(s));
     }
 
     template <typename T>
     [[nodiscard]]
-    bool operator!=(const T& s) const
+    constexpr bool operator!=(const T& s) const
     {
         return !operator==(s);
     }
 
     /*
-     * Helpers
+     * Helpers. The case conversion affects only ASCII letters; the locale is not used.
+     * The in-place variants and equalsIgnoreCase() do not make copies.
      */
     [[nodiscard]]   // nodiscard is used to emphasize that the method is not mutating
-    String<Capacity> toLowerCase() const
+    constexpr String toLowerCase() const
     {
-        String<Capacity> out;
-        std::transform(begin(), end(), std::back_inserter(out), [](char c) { return char(std::tolower(c)); });
+        String out(*this);
+        out.makeLowerCase();
         return out;
     }
 
     [[nodiscard]]   // nodiscard is used to emphasize that the method is not mutating
-    String<Capacity> toUpperCase() const
+    constexpr String toUpperCase() const
     {
-        String<Capacity> out;
-        std::transform(begin(), end(), std::back_inserter(out), [](char c) { return char(std::toupper(c)); });
+        String out(*this);
+        out.makeUpperCase();
         return out;
     }
+
+    constexpr void makeLowerCase() { StringRef(*this).makeLowerCase(); }
+
+    constexpr void makeUpperCase() { StringRef(*this).makeUpperCase(); }
+
+    [[nodiscard]]
+    constexpr bool equalsIgnoreCase(const StringView other) const { return view().equalsIgnoreCase(other); }
+
+    [[nodiscard]] constexpr const OverflowPolicy& getOverflowPolicy() const { return *this; }
+
+    /// See SENOVAL_INSTRUMENTATION.
+    using detail::Instrumented<String>::getStatistics;
+    using detail::Instrumented<String>::resetStatistics;
+
+private:
+    constexpr void reportOverflow(const OverflowKind kind)
+    {
+        this->noteOverflow();
+        this->onOverflow(kind);
+    }
+    constexpr void reportOverflow(const OverflowKind kind) const
+    {
+        this->noteOverflow();
+        this->onOverflow(kind);
+    }
+};
+
+/**
+ * Deduces the capacity of the string from the concatenation, e.g.: auto s = String(a + ":" + b);
+ */
+template <typename L, typename R>
+String(const Concatenation<L, R>&) -> String<Concatenation<L, R>::Capacity>;
+
+namespace detail
+{
+template <typename T>
+struct IsString : std::false_type {};
+
+template <std::size_t C, typename P>
+struct IsString<String<C, P>> : std::true_type {};
+
+template <typename T>
+struct IsConcatenation : std::false_type {};
+
+template <typename L, typename R>
+struct IsConcatenation<Concatenation<L, R>> : std::true_type {};
+
+template <typename T>
+struct IsCString : std::bool_constant<std::is_convertible_v<T, const char*> &&
+                                      !IsString<T>::value && !IsConcatenation<T>::value> {};
+
+/**
+ * How an operand of operator+ is kept inside the Concatenation:
+ *  - String lvalues are referenced, String rvalues (temporaries) are moved in, so they may not dangle;
+ *  - nested concatenations are stored by value; they contain nothing but references and small strings;
+ *  - anything convertible to const char* is stored as a pointer.
+ */
+template <typename T, typename D = std::remove_cv_t<std::remove_reference_t<T>>>
+using ConcatenationOperand =
+    std::conditional_t<IsString<D>::value,
+                       std::conditional_t<std::is_lvalue_reference_v<T>, const D&, D>,
+                       std::conditional_t<IsConcatenation<D>::value, D, const char*>>;
+
+template <typename T>
+struct ConcatenationOperandCapacity : std::integral_constant<std::size_t, 0> {};   ///< C strings add nothing
+
+template <std::size_t C, typename P>
+struct ConcatenationOperandCapacity<String<C, P>> : std::integral_constant<std::size_t, C> {};
+
+template <typename L, typename R>
+struct ConcatenationOperandCapacity<Concatenation<L, R>> :
+    std::integral_constant<std::size_t, Concatenation<L, R>::Capacity> {};
+
+template <typename L, typename R, typename DL = std::decay_t<L>, typename DR = std::decay_t<R>>
+struct IsConcatenable : std::bool_constant<
+    (IsString<DL>::value || IsConcatenation<DL>::value || IsCString<DL>::value) &&
+    (IsString<DR>::value || IsConcatenation<DR>::value || IsCString<DR>::value) &&
+    !(IsCString<DL>::value && IsCString<DR>::value)> {};
+
+}
+
+/**
+ * The result of operator+ on strings. Nothing is copied until the concatenation is assigned to a String<>,
+ * at which point all operands are written directly into the destination. This way, an expression like
+ * a + ":" + b + "\n" + c does not produce a chain of ever-growing temporary strings.
+ * The capacity of the result is the sum of the capacities of the String<> operands, like it used to be when
+ * operator+ returned a String<> directly; C string operands do not contribute to the capacity.
+ * Since String<> lvalue operands are kept by reference, do not let the concatenation outlive them;
+ * write "auto s = String(a + b)" if a string is needed, not "auto s = a + b".
+ */
+template <typename Left, typename Right>
+class Concatenation
+{
+    Left  left_;
+    Right right_;
+
+    template <typename T>
+    using Plain = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    template <std::size_t C, typename P, typename T>
+    static constexpr void appendOperand(String<C, P>& out, const T& operand)
+    {
+        if constexpr (detail::IsConcatenation<T>::value)
+        {
+            operand.appendTo(out);
+        }
+        else
+        {
+            out.append(operand);
+        }
+    }
+
+    template <typename T>
+    static constexpr bool isOperandWithin(const T& operand, const char* const begin, const char* const end)
+    {
+        if constexpr (detail::IsConcatenation<Plain<T>>::value)
+        {
+            return operand.overlaps(begin, end);
+        }
+        else if constexpr (std::is_reference_v<T> || std::is_pointer_v<T>)
+        {
+            const char* p = nullptr;
+            if constexpr (std::is_pointer_v<T>)
+            {
+                p = operand;
+            }
+            else
+            {
+                p = operand.data();
+            }
+            if (detail::isConstantEvaluated())
+            {
+                // Pointers into unrelated objects can't be ordered in a constant expression, but they can be
+                // tested for equality.
+                for (const char* q = begin; q != end; ++q)
+                {
+                    if (q == p)
+                    {
+                        return true;
+                    }
+                }
+                return p == end;
+            }
+            return std::less_equal<const char*>()(begin, p) && std::less_equal<const char*>()(p, end);
+        }
+        else
+        {
+            return false;   // This is a private copy, it can't overlap with anything
+        }
+    }
+
+public:
+    static constexpr std::size_t Capacity = detail::ConcatenationOperandCapacity<Plain<Left>>::value +
+                                            detail::ConcatenationOperandCapacity<Plain<Right>>::value;
+
+    template <typename L, typename R>
+    constexpr Concatenation(L&& left, R&& right) :
+        left_(std::forward<L>(left)),
+        right_(std::forward<R>(right))
+    { }
+
+    /// Writes all operands into the destination, left to right. The excess is handled by the overflow policy
+    /// of the destination.
+    template <std::size_t C, typename P>
+    constexpr void appendTo(String<C, P>& out) const
+    {
+        appendOperand(out, left_);
+        appendOperand(out, right_);
+    }
+
+    /// True if any of the referenced operands points into the specified memory range.
+    [[nodiscard]]
+    constexpr bool overlaps(const char* const begin, const char* const end) const
+    {
+        return isOperandWithin<Left>(left_, begin, end) || isOperandWithin<Right>(right_, begin, end);
+    }
 };
 
-template <std::size_t LeftCapacity, std::size_t RightCapacity>
+template <typename L, typename R, typename = std::enable_if_t<detail::IsConcatenable<L, R>::value>>
 [[nodiscard]]
-inline auto operator+(const String<LeftCapacity>& left, const String<RightCapacity>& right)
+inline constexpr auto operator+(L&& left, R&& right)
 {
-    String<LeftCapacity + RightCapacity> out(left);
-    out += right;
-    return out;
+    return Concatenation<detail::ConcatenationOperand<L>, detail::ConcatenationOperand<R>>(std::forward<L>(left),
+                                                                                         std::forward<R>(right));
 }
 
-template <std::size_t Capacity>
+template <typename L, typename R, typename T>
 [[nodiscard]]
-inline auto operator+(const String<Capacity>& left, const char* right)
+inline constexpr bool operator==(const Concatenation<L, R>& left, const T& right)
 {
-    String<Capacity> out(left);
-    out += right;
-    return out;
+    return String<Concatenation<L, R>::Capacity>(left) == right;
 }
 
-template <std::size_t Capacity>
+template <typename L, typename R, typename T>
 [[nodiscard]]
-inline auto operator+(const char* left, const String<Capacity>& right)
+inline constexpr bool operator!=(const Concatenation<L, R>& left, const T& right)
 {
-    String<Capacity> out(left);
-    out += right;
-    return out;
+    return !(left == right);
+}
+
+template <typename T, typename L, typename R,
+          typename = std::enable_if_t<!detail::IsString<T>::value && !detail::IsConcatenation<T>::value>>
+[[nodiscard]]
+inline constexpr bool operator==(const T& left, const Concatenation<L, R>& right)
+{
+    return right == left;
+}
+
+template <typename T, typename L, typename R,
+          typename = std::enable_if_t<!detail::IsString<T>::value && !detail::IsConcatenation<T>::value>>
+[[nodiscard]]
+inline constexpr bool operator!=(const T& left, const Concatenation<L, R>& right)
+{
+    return right != left;
+}
+
+/**
+ * Lexicographic ordering, e.g., for sorted containers. At least one operand shall be a String<>;
+ * the other one can be anything convertible to StringView.
+ */
+template <typename L, typename R, typename = std::enable_if_t<
+    (detail::IsString<L>::value || detail::IsString<R>::value) &&
+    std::is_convertible_v<const L&, StringView> && std::is_convertible_v<const R&, StringView>>>
+[[nodiscard]]
+inline constexpr bool operator<(const L& left, const R& right)
+{
+    return StringView(left) < StringView(right);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<
+    (detail::IsString<L>::value || detail::IsString<R>::value) &&
+    std::is_convertible_v<const L&, StringView> && std::is_convertible_v<const R&, StringView>>>
+[[nodiscard]]
+inline constexpr bool operator>(const L& left, const R& right)
+{
+    return StringView(right) < StringView(left);
+}
+
+template <typename L, typename R, typename = std::enable_if_t<
+    (detail::IsString<L>::value || detail::IsString<R>::value) &&
+    std::is_convertible_v<const L&, StringView> && std::is_convertible_v<const R&, StringView>>>
+[[nodiscard]]
+inline constexpr bool operator<=(const L& left, const R& right)
+{
+    return !(StringView(right) < StringView(left));
+}
+
+template <typename L, typename R, typename = std::enable_if_t<
+    (detail::IsString<L>::value || detail::IsString<R>::value) &&
+    std::is_convertible_v<const L&, StringView> && std::is_convertible_v<const R&, StringView>>>
+[[nodiscard]]
+inline constexpr bool operator>=(const L& left, const R& right)
+{
+    return !(StringView(left) < StringView(right));
 }
 
-template <std::size_t Capacity>
+template <std::size_t Capacity, typename Policy>
 [[nodiscard]]
-inline bool operator==(const char* left, const String<Capacity>& right)
+inline constexpr bool operator==(const char* left, const String<Capacity, Policy>& right)
 {
     return right == left;
 }
 
-template <std::size_t Capacity>
+template <std::size_t Capacity, typename Policy>
 [[nodiscard]]
-inline bool operator!=(const char* left, const String<Capacity>& right)
+inline constexpr bool operator!=(const char* left, const String<Capacity, Policy>& right)
 {
     return right != left;
 }
 
 }
+
+/// Consistent with std::hash<senoval::StringView>, so heterogeneous lookup works.
+template <std::size_t Capacity, typename Policy>
+struct std::hash<senoval::String<Capacity, Policy>>
+{
+    std::size_t operator()(const senoval::String<Capacity, Policy>& s) const noexcept { return s.hash(); }
+};
@@ -0,0 +1,451 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+#pragma once
+
+#if __cplusplus < 201703
+# error "This library requires C++17 or newer"
+#endif
+
+#include "common.hpp"
+#include <string>
+#include <string_view>
+#include <functional>
+#include <iterator>
+#include <cstddef>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+
+
+namespace senoval
+{
+
+class TokenRange;
+
+/**
+ * A non-owning reference to a sequence of chars, API like std::string_view (including the C++20 additions).
+ * String<> converts to it implicitly and for free. The referenced sequence need not be null-terminated.
+ * Unlike std::string_view, the API never throws: out-of-range positions are clamped to the end of the view.
+ * Instances of std::string_view and StringView are interconvertible.
+ * All operations are usable in constant expressions.
+ */
+class StringView
+{
+    using Traits = std::char_traits<char>;
+
+    const char* ptr_ = nullptr;
+    std::size_t len_ = 0;
+
+public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    constexpr StringView() = default;
+
+    /// Implicit on purpose. The argument shall be null-terminated.
+    constexpr StringView(const char* const s) : // NOLINT
+        ptr_(s),
+        len_((s == nullptr) ? 0 : Traits::length(s))
+    { }
+
+    constexpr StringView(const char* const s, const std::size_t length) :
+        ptr_(s),
+        len_(length)
+    { }
+
+    constexpr StringView(const std::string_view s) : // NOLINT
+        ptr_(s.data()),
+        len_(s.size())
+    { }
+
+    constexpr operator std::string_view() const { return std::string_view(ptr_, len_); }  // NOLINT
+
+    /*
+     * std::string_view API
+     */
+    using value_type = char;
+    using size_type = std::size_t;
+    using iterator = const char*;
+    using const_iterator = const char*;
+
+    [[nodiscard]] constexpr std::size_t size()   const { return len_; }
+    [[nodiscard]] constexpr std::size_t length() const { return len_; }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    constexpr bool empty() const { return len_ == 0; }
+
+    [[nodiscard]] constexpr const char* data()  const { return ptr_; }
+    [[nodiscard]] constexpr const char* begin() const { return ptr_; }
+    [[nodiscard]] constexpr const char* end()   const { return ptr_ + len_; }
+
+    [[nodiscard]]
+    constexpr const char& operator[](const std::size_t index) const
+    {
+        assert(index < len_);
+        return ptr_[index];
+    }
+
+    [[nodiscard]] constexpr const char& front() const { return operator[](0); }
+    [[nodiscard]] constexpr const char& back()  const { return operator[](len_ - 1U); }
+
+    constexpr void remove_prefix(const std::size_t n)
+    {
+        const std::size_t k = (n < len_) ? n : len_;
+        ptr_ += k;
+        len_ -= k;
+    }
+
+    constexpr void remove_suffix(const std::size_t n)
+    {
+        len_ -= (n < len_) ? n : len_;
+    }
+
+    [[nodiscard]]
+    constexpr StringView substr(std::size_t pos = 0, const std::size_t count = npos) const
+    {
+        pos = (pos < len_) ? pos : len_;
+        const std::size_t rest = len_ - pos;
+        return StringView(ptr_ + pos, (count < rest) ? count : rest);
+    }
+
+    [[nodiscard]]
+    constexpr int compare(const StringView other) const
+    {
+        const std::size_t n = (len_ < other.len_) ? len_ : other.len_;
+        const int result = (n > 0) ? Traits::compare(ptr_, other.ptr_, n) : 0;
+        if (result != 0)
+        {
+            return result;
+        }
+        return (len_ == other.len_) ? 0 : ((len_ < other.len_) ? -1 : 1);
+    }
+
+    /**
+     * 32-bit FNV-1a hash of the contents. The value is stable: it is the same on every platform
+     * and at compile time, so the hashes of literals can be precomputed, e.g. in case labels.
+     */
+    [[nodiscard]]
+    constexpr std::uint32_t hash() const { return detail::computeFNV1aHash(ptr_, len_); }
+
+    /// ASCII-only, the locale is not used. Prefer this over comparing case-folded copies.
+    [[nodiscard]]
+    constexpr bool equalsIgnoreCase(const StringView other) const
+    {
+        return (len_ == other.len_) && detail::equalsIgnoreCase(ptr_, other.ptr_, len_);
+    }
+
+    [[nodiscard]]
+    constexpr bool starts_with(const StringView prefix) const
+    {
+        return (len_ >= prefix.len_) && (substr(0, prefix.len_) == prefix);
+    }
+
+    [[nodiscard]]
+    constexpr bool starts_with(const char c) const { return (len_ > 0) && (ptr_[0] == c); }
+
+    [[nodiscard]]
+    constexpr bool ends_with(const StringView suffix) const
+    {
+        return (len_ >= suffix.len_) && (substr(len_ - suffix.len_) == suffix);
+    }
+
+    [[nodiscard]]
+    constexpr bool ends_with(const char c) const { return (len_ > 0) && (ptr_[len_ - 1U] == c); }
+
+    /*
+     * Search. Each method returns the position of the match or npos.
+     */
+    [[nodiscard]]
+    constexpr std::size_t find(const char c, const std::size_t pos = 0) const
+    {
+        if (pos >= len_)
+        {
+            return npos;
+        }
+        const char* const p = Traits::find(ptr_ + pos, len_ - pos, c);
+        return (p == nullptr) ? npos : std::size_t(p - ptr_);
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t find(const StringView needle, std::size_t pos = 0) const
+    {
+        if (needle.empty())
+        {
+            return (pos <= len_) ? pos : npos;
+        }
+        while ((pos = find(needle.front(), pos)) != npos)
+        {
+            if ((len_ - pos) < needle.len_)
+            {
+                break;
+            }
+            if (Traits::compare(ptr_ + pos, needle.ptr_, needle.len_) == 0)
+            {
+                return pos;
+            }
+            ++pos;
+        }
+        return npos;
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t rfind(const char c, const std::size_t pos = npos) const
+    {
+        std::size_t i = (pos < len_) ? (pos + 1U) : len_;
+        while (i-- > 0)
+        {
+            if (ptr_[i] == c)
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t find_first_of(const StringView chars, const std::size_t pos = 0) const
+    {
+        for (std::size_t i = pos; i < len_; i++)
+        {
+            if (chars.find(ptr_[i]) != npos)
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    [[nodiscard]]
+    constexpr std::size_t find_first_not_of(const StringView chars, const std::size_t pos = 0) const
+    {
+        for (std::size_t i = pos; i < len_; i++)
+        {
+            if (chars.find(ptr_[i]) == npos)
+            {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    [[nodiscard]]
+    constexpr bool contains(const StringView needle) const { return find(needle) != npos; }
+
+    [[nodiscard]]
+    constexpr bool contains(const char c) const { return find(c) != npos; }
+
+    /*
+     * Helpers
+     */
+    /// Removes leading and trailing whitespace (or other specified characters).
+    [[nodiscard]]
+    constexpr StringView trim(const StringView chars = " \t\r\n") const
+    {
+        StringView out = *this;
+        while (!out.empty() && chars.contains(out.front()))
+        {
+            out.remove_prefix(1);
+        }
+        while (!out.empty() && chars.contains(out.back()))
+        {
+            out.remove_suffix(1);
+        }
+        return out;
+    }
+
+    /**
+     * Iterates over the fields separated by the delimiter, including empty ones, like in CSV:
+     *      "a,,b" --> "a", "", "b"
+     * An empty view yields one empty field. No copying is done; the fields point into this view.
+     */
+    [[nodiscard]] constexpr TokenRange split(const char delimiter) const;
+
+    /**
+     * Iterates over the non-empty tokens separated by any number of the delimiter characters, like in a shell:
+     *      "  set motor.kp\t0.12 " --> "set", "motor.kp", "0.12"
+     * The delimiters are referenced, not copied, so they shall outlive the range (string literals are fine).
+     */
+    [[nodiscard]] constexpr TokenRange tokenize(const StringView delimiters = " \t\r\n") const;
+
+    /*
+     * Operators
+     */
+    [[nodiscard]]
+    friend constexpr bool operator==(const StringView left, const StringView right)
+    {
+        return (left.len_ == right.len_) && detail::equalChars(left.ptr_, right.ptr_, left.len_);
+    }
+
+    [[nodiscard]]
+    friend constexpr bool operator!=(const StringView left, const StringView right) { return !(left == right); }
+
+    [[nodiscard]]
+    friend constexpr bool operator<(const StringView left, const StringView right) { return left.compare(right) < 0; }
+
+    [[nodiscard]]
+    friend constexpr bool operator>(const StringView left, const StringView right) { return right < left; }
+
+    [[nodiscard]]
+    friend constexpr bool operator<=(const StringView left, const StringView right) { return !(right < left); }
+
+    [[nodiscard]]
+    friend constexpr bool operator>=(const StringView left, const StringView right) { return !(left < right); }
+};
+
+/**
+ * A lazy range of tokens returned by StringView::split() and StringView::tokenize().
+ * Usage:
+ *      for (StringView token : line.tokenize()) { ... }
+ * The iterator can also be advanced manually, which is handy for parsing command lines:
+ *      auto it = line.tokenize().begin();
+ *      const StringView command = *it++;
+ */
+class TokenRange
+{
+public:
+    class Iterator
+    {
+        StringView token_;
+        StringView rest_;
+        StringView delimiters_;     ///< Used only if empty tokens are skipped.
+        char delimiter_ = '\0';     ///< Used only if empty tokens are not skipped.
+        bool skip_empty_ = false;
+        bool has_rest_ = false;     ///< There is at least one more field after the current one.
+        bool done_ = true;
+
+        constexpr void advance()
+        {
+            if (skip_empty_)
+            {
+                rest_.remove_prefix(rest_.find_first_not_of(delimiters_));
+                done_ = rest_.empty();
+                const std::size_t end = rest_.find_first_of(delimiters_);
+                token_ = rest_.substr(0, end);
+                rest_.remove_prefix(end);
+            }
+            else
+            {
+                done_ = !has_rest_;
+                const std::size_t end = rest_.find(delimiter_);
+                has_rest_ = end != StringView::npos;
+                token_ = rest_.substr(0, end);
+                rest_.remove_prefix(has_rest_ ? (end + 1U) : end);
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = StringView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const StringView*;
+        using reference = const StringView&;
+
+        constexpr Iterator() = default;
+
+        constexpr Iterator(const StringView source,
+                           const StringView delimiters,
+                           const char delimiter,
+                           const bool skip_empty) :
+            rest_(source),
+            delimiters_(delimiters),
+            delimiter_(delimiter),
+            skip_empty_(skip_empty),
+            has_rest_(true),
+            done_(false)
+        {
+            advance();
+        }
+
+        [[nodiscard]] constexpr const StringView& operator*()  const { return token_; }
+        [[nodiscard]] constexpr const StringView* operator->() const { return &token_; }
+
+        constexpr Iterator& operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        constexpr Iterator operator++(int)
+        {
+            const Iterator old = *this;
+            advance();
+            return old;
+        }
+
+        /// The unparsed part of the source following the current token (and its delimiter, if splitting).
+        [[nodiscard]] constexpr StringView getRemainder() const { return rest_; }
+
+        [[nodiscard]]
+        constexpr bool operator==(const Iterator& other) const
+        {
+            return (done_ && other.done_) ||
+                   ((done_ == other.done_) && (has_rest_ == other.has_rest_) &&
+                    (token_.data() == other.token_.data()) && (token_.size() == other.token_.size()));
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const Iterator& other) const { return !operator==(other); }
+    };
+
+private:
+    StringView source_;
+    StringView delimiters_;
+    char delimiter_ = '\0';
+    bool skip_empty_ = false;
+
+public:
+    constexpr TokenRange(const StringView source,
+                         const StringView delimiters,
+                         const char delimiter,
+                         const bool skip_empty) :
+        source_(source),
+        delimiters_(delimiters),
+        delimiter_(delimiter),
+        skip_empty_(skip_empty)
+    { }
+
+    [[nodiscard]]
+    constexpr Iterator begin() const { return Iterator(source_, delimiters_, delimiter_, skip_empty_); }
+
+    [[nodiscard]]
+    constexpr Iterator end() const { return Iterator(); }
+};
+
+constexpr TokenRange StringView::split(const char delimiter) const
+{
+    return TokenRange(*this, StringView(), delimiter, false);
+}
+
+constexpr TokenRange StringView::tokenize(const StringView delimiters) const
+{
+    return TokenRange(*this, delimiters, '\0', true);
+}
+
+}
+
+template <>
+struct std::hash<senoval::StringView>
+{
+    std::size_t operator()(const senoval::StringView s) const noexcept { return s.hash(); }
+};
@@ -29,68 +29,490 @@
 # error "This library requires C++17 or newer"
 #endif
 
+#include "common.hpp"
+#include "instrumentation.hpp"
+#include "overflow.hpp"
 #include <algorithm>
 #include <iterator>
 #include <cstring>
 #include <cassert>
 #include <cstdint>
+#include <new>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <initializer_list>
 
 
 namespace senoval
 {
+namespace detail
+{
+/// True if the elements of the container are stored contiguously and can be read as an array of T.
+template <typename Container, typename T, typename = void>
+struct IsContiguousOf : std::false_type {};
+
+template <typename Container, typename T>
+struct IsContiguousOf<Container, T, std::enable_if_t<
+    std::is_convertible_v<decltype(std::data(std::declval<const Container&>())), const T*> &&
+    std::is_integral_v<decltype(std::size(std::declval<const Container&>()))>>> : std::true_type {};
+
 /**
- * A vector with fixed storage, API like std::vector<>.
- * This implementation supports only trivial types, since that is sufficient for the needs of this library.
- * Support for non-trivial types may be added in the future in a fully backward-compatible way.
+ * Trivial types are stored in a plain array, so that the vector itself remains trivially copyable
+ * and nothing is done on copy or destruction except copying the bytes.
+ */
+template <typename T, std::size_t Capacity, bool = std::is_trivial_v<T>>
+class VectorStorage
+{
+protected:
+    // The length goes after the buffer so that a narrow length type does not introduce padding.
+    T buf_[Capacity];       // Note that we don't zero-initialize, just like std containers
+    SmallestUnsignedFor<Capacity> len_ = 0;
+
+    [[nodiscard]] T*       getElements()       { return &buf_[0]; }
+    [[nodiscard]] const T* getElements() const { return &buf_[0]; }
+};
+
+/**
+ * Other types are constructed in uninitialized storage; the lifetimes of the elements are managed here.
+ * A moved-from vector is left empty, like std::vector<>.
+ */
+template <typename T, std::size_t Capacity>
+class VectorStorage<T, Capacity, false>
+{
+protected:
+    alignas(T) unsigned char raw_[sizeof(T) * Capacity];
+    SmallestUnsignedFor<Capacity> len_ = 0;
+
+    [[nodiscard]] T*       getElements()       { return std::launder(reinterpret_cast<T*>(&raw_[0])); }
+    [[nodiscard]] const T* getElements() const { return std::launder(reinterpret_cast<const T*>(&raw_[0])); }
+
+    void destroyFrom(const std::size_t new_length)
+    {
+        while (len_ > new_length)
+        {
+            --len_;
+            std::destroy_at(getElements() + len_);
+        }
+    }
+
+    template <typename Source>
+    void constructFrom(Source&& other)
+    {
+        for (std::size_t i = 0; i < other.len_; i++)
+        {
+            if constexpr (std::is_lvalue_reference_v<Source>)
+            {
+                ::new (static_cast<void*>(getElements() + i)) T(other.getElements()[i]);
+            }
+            else
+            {
+                ::new (static_cast<void*>(getElements() + i)) T(std::move(other.getElements()[i]));
+            }
+            len_ = decltype(len_)(i + 1U);
+        }
+    }
+
+    VectorStorage() { }     // NOLINT the storage is not initialized on purpose
+
+    VectorStorage(const VectorStorage& other) { constructFrom(other); }
+
+    VectorStorage(VectorStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        constructFrom(std::move(other));
+        other.destroyFrom(0);
+    }
+
+    VectorStorage& operator=(const VectorStorage& other)
+    {
+        if (this != &other)
+        {
+            destroyFrom(0);
+            constructFrom(other);
+        }
+        return *this;
+    }
+
+    VectorStorage& operator=(VectorStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            destroyFrom(0);
+            constructFrom(std::move(other));
+            other.destroyFrom(0);
+        }
+        return *this;
+    }
+
+    ~VectorStorage() { destroyFrom(0); }
+};
+
+}
+
+template <typename T, std::size_t Capacity_, typename OverflowPolicy_ = overflow::Assert>
+class Vector;
+
+/**
+ * A non-owning reference to a Vector<> of any capacity with the element type T.
+ * Code that accepts VectorRef<T> is compiled once per element type rather than once per capacity;
+ * the bulk modifiers of Vector<> are implemented here for the same reason. The semantics are those of Vector<>.
+ * A read-only sequence is better passed as Span<const T>.
  */
-template <typename T, std::size_t Capacity_>
-class Vector
+template <typename T>
+class VectorRef
 {
+    T* elements_;
+    std::size_t capacity_;
+    detail::LengthRef len_;
+
 public:
-    static constexpr std::size_t Capacity = Capacity_;
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
 
-    static_assert(Capacity > 0, "Capacity must be positive");
-    static_assert(std::is_trivial<T>::value, "This implementation supports only trivial types.");
+    /// The first *length elements shall be alive; the length type shall be one of SmallestUnsignedFor<>.
+    template <typename L>
+    VectorRef(T* const elements, const std::size_t capacity, L* const length) :
+        elements_(elements),
+        capacity_(capacity),
+        len_(length)
+    {
+        assert(*length <= capacity);
+    }
+
+    template <std::size_t C, typename P>
+    VectorRef(Vector<T, C, P>& vector) :    // NOLINT implicit by design
+        VectorRef(vector.getElements(), C, &vector.len_)
+    { }
+
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+    [[nodiscard]] std::size_t max_size() const { return capacity_; }
+
+    [[nodiscard]] std::size_t size() const { return len_.get(); }
+
+    [[nodiscard]] // nodiscard prevents confusion with clear()
+    bool empty() const { return size() == 0; }
+
+    [[nodiscard]] T* begin() const { return elements_; }
+    [[nodiscard]] T* end()   const { return elements_ + size(); }
+    [[nodiscard]] T* data()  const { return elements_; }
+
+    [[nodiscard]]
+    T& operator[](const std::size_t index) const
+    {
+        if (index < size())
+        {
+            return elements_[index];
+        }
+        else
+        {
+            assert(false);
+            return back();
+        }
+    }
+
+    [[nodiscard]] T& front() const { return operator[](0); }
+
+    [[nodiscard]]
+    T& back() const
+    {
+        const std::size_t len = size();
+        if (len > 0)
+        {
+            return elements_[len - 1U];
+        }
+        else
+        {
+            assert(false);
+            return elements_[0];
+        }
+    }
+
+    void clear() const { truncate(0); }
+
+    void resize(const std::size_t count, const T& fill_value = T{}) const
+    {
+        assert(count <= capacity_);
+        if (count < size())
+        {
+            truncate(count);
+        }
+        else
+        {
+            (void) insert(end(), count - size(), fill_value);
+        }
+        assert(size() == count);    // Will fail if count > capacity
+    }
+
+    template <typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    iterator insert(const const_iterator position, InputIterator first, const InputIterator last) const
+    {
+        const std::size_t offset = getOffset(position);
+        const std::size_t len = size();
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_convertible_v<InputIterator, const T*>)
+        {
+            const T* const source = first;
+            const std::size_t count = std::min(std::size_t(last - first), capacity_ - len);
+            if (count > 0)
+            {
+                T* const p = elements_ + offset;
+                std::memmove(p + count, p, (len - offset) * sizeof(T));
+                std::memcpy(p, source, count * sizeof(T));
+                len_.set(len + count);
+            }
+        }
+        else
+        {
+            for (std::size_t n = len; (first != last) && (n < capacity_); n++)
+            {
+                (void) emplace_back(*first);
+                ++first;
+            }
+            std::rotate(begin() + offset, begin() + len, end());
+        }
+        return begin() + offset;
+    }
+
+    iterator insert(const const_iterator position, const std::initializer_list<T> values) const
+    {
+        return insert(position, values.begin(), values.end());
+    }
+
+    iterator insert(const const_iterator position, const std::size_t count, const T& value) const
+    {
+        const std::size_t offset = getOffset(position);
+        const std::size_t len = size();
+        const std::size_t n = std::min(count, capacity_ - len);
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            const T copy = value;       // The value may be an element of this vector
+            T* const p = elements_ + offset;
+            std::memmove(p + n, p, (len - offset) * sizeof(T));
+            std::uninitialized_fill_n(p, n, copy);
+            len_.set(len + n);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                (void) emplace_back(value);
+            }
+            std::rotate(begin() + offset, begin() + len, end());
+        }
+        return begin() + offset;
+    }
+
+    iterator insert(const const_iterator position, const T& value) const { return emplace(position, value); }
+    iterator insert(const const_iterator position, T&& value) const { return emplace(position, std::move(value)); }
+
+    template <typename... Args>
+    iterator emplace(const const_iterator position, Args&&... args) const
+    {
+        const std::size_t offset = getOffset(position);
+        const std::size_t len = size();
+        if (len < capacity_)
+        {
+            if constexpr (std::is_trivially_copyable_v<T>)
+            {
+                const T value(std::forward<Args>(args)...);
+                T* const p = elements_ + offset;
+                std::memmove(p + 1, p, (len - offset) * sizeof(T));
+                std::memcpy(p, &value, sizeof(T));
+                len_.set(len + 1U);
+            }
+            else
+            {
+                (void) emplace_back(std::forward<Args>(args)...);
+                std::rotate(begin() + offset, end() - 1, end());
+            }
+        }
+        else
+        {
+            assert(false);
+        }
+        return begin() + offset;
+    }
+
+    iterator erase(const const_iterator first, const const_iterator last) const
+    {
+        const std::size_t len = size();
+        const std::size_t offset = std::size_t(first - elements_);
+        const std::size_t end_offset = std::size_t(last - elements_);
+        assert((first >= elements_) && (offset <= end_offset) && (end_offset <= len));
+        const std::size_t count = end_offset - offset;
+        T* const p = elements_ + offset;
+        if constexpr (std::is_trivially_copyable_v<T>)
+        {
+            std::memmove(p, p + count, (len - end_offset) * sizeof(T));
+            len_.set(len - count);
+        }
+        else
+        {
+            (void) std::move(p + count, end(), p);
+            truncate(len - count);
+        }
+        return p;
+    }
+
+    iterator erase(const const_iterator position) const
+    {
+        assert(position < end());
+        return erase(position, position + 1);
+    }
+
+    template <typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    void assign(const InputIterator first, const InputIterator last) const
+    {
+        clear();
+        (void) insert(end(), first, last);
+    }
+
+    void assign(const std::initializer_list<T> values) const
+    {
+        assign(values.begin(), values.end());
+    }
+
+    void assign(const std::size_t count, const T& value) const
+    {
+        const T copy = value;           // The value may be an element of this vector
+        clear();
+        (void) insert(end(), count, copy);
+    }
+
+    template <typename Container, typename = decltype(std::begin(std::declval<Container>()))>
+    void append(const Container& other) const
+    {
+        if constexpr (detail::IsContiguousOf<Container, T>::value)
+        {
+            (void) insert(end(), std::data(other), std::data(other) + std::size(other));
+        }
+        else
+        {
+            (void) insert(end(), std::begin(other), std::end(other));
+        }
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) const
+    {
+        const std::size_t len = size();
+        if (len < capacity_)
+        {
+            T* const p = ::new (static_cast<void*>(elements_ + len)) T(std::forward<Args>(args)...);
+            len_.set(len + 1U);
+            return *p;
+        }
+        else
+        {
+            assert(false);
+            return back();
+        }
+    }
+
+    void push_back(const T& c) const { (void) emplace_back(c); }
+    void push_back(T&& c)      const { (void) emplace_back(std::move(c)); }
+
+    void pop_back() const
+    {
+        const std::size_t len = size();
+        if (len > 0)
+        {
+            truncate(len - 1U);
+        }
+        else
+        {
+            assert(false);
+        }
+    }
 
 private:
-    std::size_t len_ = 0;
-    T buf_[Capacity];       // Note that we don't zero-initialize, just like std containers
+    [[nodiscard]]
+    std::size_t getOffset(const const_iterator position) const
+    {
+        assert((position >= begin()) && (position <= end()));
+        return std::size_t(position - begin());
+    }
+
+    void truncate(const std::size_t new_length) const
+    {
+        if constexpr (std::is_trivially_destructible_v<T>)
+        {
+            len_.set(new_length);
+        }
+        else
+        {
+            for (std::size_t len = size(); len > new_length;)
+            {
+                --len;
+                len_.set(len);
+                std::destroy_at(elements_ + len);
+            }
+        }
+    }
+};
+
+/**
+ * A vector with fixed storage, API like std::vector<>.
+ * Trivial types are kept in a plain array at no overhead compared to a raw array plus a length.
+ * Other types are constructed in place in uninitialized storage and destroyed when removed.
+ * The overflow policy defines what happens when the elements do not fit or an access is out of range;
+ * by default, it is an assertion failure. See senoval::overflow.
+ */
+template <typename T, std::size_t Capacity_, typename OverflowPolicy_>
+class Vector : private detail::VectorStorage<T, Capacity_>,
+               private OverflowPolicy_,
+               private detail::Instrumented<Vector<T, Capacity_, OverflowPolicy_>>
+{
+    using Storage = detail::VectorStorage<T, Capacity_>;
+    using Storage::len_;
+    using Storage::getElements;
+
+    friend class VectorRef<T>;
 
 public:
+    static constexpr std::size_t Capacity = Capacity_;
+    using OverflowPolicy = OverflowPolicy_;
+
+    static_assert(Capacity > 0, "Capacity must be positive");
+
     Vector() = default;
 
     // Implicit by design
     Vector(std::initializer_list<T> values)
     {
-        for (const auto& v : values)
+        if (values.size() > Capacity)
         {
-            push_back(v);
+            reportOverflow(OverflowKind::Capacity);
         }
+        (void) VectorRef<T>(*this).insert(end(), values.begin(), values.end());
+        this->noteSize(len_);
     }
 
+    /// Excess elements are discarded.
     template <typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
     Vector(InputIterator begin, const InputIterator end) // NOLINT
     {
-        while ((begin != end) && (len_ < Capacity))
-        {
-            buf_[len_] = T(*begin);
-            ++len_;
-            ++begin;
-        }
+        (void) insert(this->end(), begin, end);
     }
 
     Vector(std::size_t count, const T& value)
     {
-        while (count --> 0)
+        if (count > Capacity)
         {
-            push_back(value);
+            reportOverflow(OverflowKind::Capacity);
         }
+        (void) VectorRef<T>(*this).insert(end(), count, value);
+        this->noteSize(len_);
     }
 
+    /// Excess elements are discarded. Contiguous sequences of trivial types are copied with a single memcpy().
     template <typename Container, typename = decltype(std::begin(std::declval<Container>()))>
     void append(const Container& other)
     {
-        std::copy(std::begin(other), std::end(other), std::back_inserter(*this));
+        checkInsertion(std::begin(other), std::end(other));
+        VectorRef<T>(*this).append(other);
+        this->noteSize(len_);
     }
 
     /*
@@ -111,49 +533,148 @@ public:
 
     void clear()
     {
-        len_ = 0;
+        truncate(0);
     }
 
+    /// The size is clamped to the capacity; exceeding it is an error like push_back() into a full vector.
     void resize(const std::size_t count, const T& fill_value = T{})
     {
-        assert(count <= Capacity);
-        if (count < len_)
+        if (count > Capacity)
         {
-            len_ = count;
+            reportOverflow(OverflowKind::Capacity);
         }
-        else
+        VectorRef<T>(*this).resize(std::min(count, Capacity), fill_value);
+        this->noteSize(len_);
+    }
+
+    /*
+     * Bulk modifiers. Like append(), they never exceed the capacity: the elements that do not fit are not inserted,
+     * and the existing elements are never dropped. For trivially copyable types, each operation is a memmove()
+     * followed by a memcpy() or a fill; otherwise, the new elements are constructed at the end and rotated into place.
+     * The truncation is reported to the overflow policy, except for single-pass input iterators.
+     * The source range shall not point into this vector.
+     * The implementation is in VectorRef<>, so that it is shared by all capacities.
+     */
+    template <typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    iterator insert(const const_iterator position, InputIterator first, const InputIterator last)
+    {
+        checkInsertion(first, last);
+        const iterator out = VectorRef<T>(*this).insert(position, first, last);
+        this->noteSize(len_);
+        return out;
+    }
+
+    iterator insert(const const_iterator position, const std::initializer_list<T> values)
+    {
+        return insert(position, values.begin(), values.end());
+    }
+
+    iterator insert(const const_iterator position, const std::size_t count, const T& value)
+    {
+        if (count > (Capacity - len_))
         {
-            while (count > len_)
-            {
-                push_back(fill_value);
-            }
+            reportOverflow(OverflowKind::Truncation);
         }
-        assert(size() == count);    // Will fail if count > Capacity
+        const iterator out = VectorRef<T>(*this).insert(position, count, value);
+        this->noteSize(len_);
+        return out;
     }
 
-    void push_back(const T& c)
+    iterator insert(const const_iterator position, const T& value) { return emplace(position, value); }
+    iterator insert(const const_iterator position, T&& value)      { return emplace(position, std::move(value)); }
+
+    /// If the vector is full, nothing is inserted.
+    template <typename... Args>
+    iterator emplace(const const_iterator position, Args&&... args)
     {
-        if (len_ < Capacity)
+        if (len_ >= Capacity)
         {
-            buf_[len_] = c;
-            ++len_;
+            reportOverflow(OverflowKind::Capacity);
+            return const_cast<iterator>(position);
         }
-        else
+        const iterator out = VectorRef<T>(*this).emplace(position, std::forward<Args>(args)...);
+        this->noteSize(len_);
+        return out;
+    }
+
+    iterator erase(const const_iterator first, const const_iterator last)
+    {
+        return VectorRef<T>(*this).erase(first, last);
+    }
+
+    iterator erase(const const_iterator position)
+    {
+        return VectorRef<T>(*this).erase(position);
+    }
+
+    template <typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    void assign(const InputIterator first, const InputIterator last)
+    {
+        clear();
+        checkInsertion(first, last);
+        VectorRef<T>(*this).assign(first, last);
+        this->noteSize(len_);
+    }
+
+    void assign(const std::initializer_list<T> values)
+    {
+        assign(values.begin(), values.end());
+    }
+
+    void assign(const std::size_t count, const T& value)
+    {
+        if (count > Capacity)
         {
-            assert(false);
+            reportOverflow(OverflowKind::Truncation);
         }
+        VectorRef<T>(*this).assign(count, value);
+        this->noteSize(len_);
     }
 
-    void pop_back()
+    /**
+     * Constructs the element in place and returns a reference to it.
+     * If the vector is full, nothing is constructed, and the reference is to the last element.
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
     {
-        if (len_ > 0)
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            --len_;
+            if (len_ >= Capacity)
+            {
+                reportOverflow(OverflowKind::Capacity);
+                return getElements()[Capacity - 1U];
+            }
         }
-        else
+        assert(len_ < Capacity);
+        T* const p = ::new (static_cast<void*>(getElements() + len_)) T(std::forward<Args>(args)...);
+        ++len_;
+        this->noteSize(len_);
+        return *p;
+    }
+
+    void push_back(const T& c)
+    {
+        (void) emplace_back(c);
+    }
+
+    void push_back(T&& c)
+    {
+        (void) emplace_back(std::move(c));
+    }
+
+    void pop_back()
+    {
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            assert(false);
+            if (len_ == 0)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return;
+            }
         }
+        assert(len_ > 0);
+        truncate(len_ - 1U);
     }
 
     [[nodiscard]] T&       front()       { return operator[](0); }
@@ -162,26 +683,40 @@ public:
     [[nodiscard]]
     T& back()
     {
-        if (len_ > 0)
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            return buf_[len_ - 1U];
+            if (len_ == 0)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return getElements()[0];
+            }
         }
-        else
+        assert(len_ > 0);
+        return getElements()[len_ - 1U];
+    }
+    [[nodiscard]]
+    const T& back() const
+    {
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            assert(false);
-            return buf_[0];
+            if (len_ == 0)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return getElements()[0];
+            }
         }
+        assert(len_ > 0);
+        return getElements()[len_ - 1U];
     }
-    [[nodiscard]] const T& back() const { return const_cast<Vector*>(this)->back(); }
 
-    [[nodiscard]] T* begin() { return &buf_[0]; }
-    [[nodiscard]] T* end()   { return &buf_[len_]; }
+    [[nodiscard]] T* begin() { return getElements(); }
+    [[nodiscard]] T* end()   { return getElements() + len_; }
 
-    [[nodiscard]] const T* begin() const { return &buf_[0]; }
-    [[nodiscard]] const T* end()   const { return &buf_[len_]; }
+    [[nodiscard]] const T* begin() const { return getElements(); }
+    [[nodiscard]] const T* end()   const { return getElements() + len_; }
 
-    [[nodiscard]] T* data() { return &buf_[0]; }
-    [[nodiscard]] const T* data() const { return &buf_[0]; }
+    [[nodiscard]] T* data() { return getElements(); }
+    [[nodiscard]] const T* data() const { return getElements(); }
 
     /*
      * Operators
@@ -189,20 +724,30 @@ public:
     [[nodiscard]]
     T& operator[](std::size_t index)
     {
-        if (index < len_)
+        if constexpr (OverflowPolicy::IsChecked)
         {
-            return buf_[index];
-        }
-        else
-        {
-            assert(false);
-            return back();
+            if (index >= len_)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return getElements()[(len_ > 0) ? (len_ - 1U) : 0U];
+            }
         }
+        assert(index < len_);
+        return getElements()[index];
     }
     [[nodiscard]]
     const T& operator[](std::size_t index) const
     {
-        return const_cast<Vector*>(this)->operator[](index);
+        if constexpr (OverflowPolicy::IsChecked)
+        {
+            if (index >= len_)
+            {
+                reportOverflow(OverflowKind::OutOfRange);
+                return getElements()[(len_ > 0) ? (len_ - 1U) : 0U];
+            }
+        }
+        assert(index < len_);
+        return getElements()[index];
     }
 
     template <typename S, typename = decltype(std::declval<S>().begin())>
@@ -218,6 +763,50 @@ public:
     {
         return !operator==(s);
     }
+
+    [[nodiscard]] const OverflowPolicy& getOverflowPolicy() const { return *this; }
+
+    /// See SENOVAL_INSTRUMENTATION.
+    using detail::Instrumented<Vector>::getStatistics;
+    using detail::Instrumented<Vector>::resetStatistics;
+
+private:
+    void reportOverflow(const OverflowKind kind)
+    {
+        this->noteOverflow();
+        this->onOverflow(kind);
+    }
+    void reportOverflow(const OverflowKind kind) const
+    {
+        this->noteOverflow();
+        this->onOverflow(kind);
+    }
+
+    /// Reports the truncation of a range that is about to be inserted. Single-pass ranges can't be measured.
+    template <typename Iterator>
+    void checkInsertion(const Iterator first, const Iterator last)
+    {
+        using Category = typename std::iterator_traits<Iterator>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+        {
+            if (std::size_t(std::distance(first, last)) > (Capacity - len_))
+            {
+                reportOverflow(OverflowKind::Truncation);
+            }
+        }
+    }
+
+    void truncate(const std::size_t new_length)
+    {
+        if constexpr (std::is_trivially_destructible_v<T>)
+        {
+            len_ = decltype(len_)(new_length);
+        }
+        else
+        {
+            this->destroyFrom(new_length);
+        }
+    }
 };
 
 }
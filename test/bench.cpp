@@ -0,0 +1,216 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// Micro-benchmarks of the library; see bench.hpp for the output format. Should be built with optimizations.
+// The functions under test are invoked through the public API with inputs unknown to the compiler.
+
+#include "bench.hpp"
+#include <senoval/string.hpp>
+#include <senoval/vector.hpp>
+#include <senoval/comparison.hpp>
+#include <senoval/serial.hpp>
+#include <senoval/snapshot.hpp>
+#include <cstdint>
+#include <cstddef>
+
+using namespace senoval;
+
+namespace
+{
+constexpr std::size_t DataSize = 256;
+
+/// Pseudo-random inputs that the compiler can't see through.
+struct Inputs
+{
+    std::uint32_t integers[DataSize]{};
+    float floats_a[DataSize]{};
+    float floats_b[DataSize]{};
+
+    Inputs()
+    {
+        std::uint32_t x = 0x12345678U;
+        for (std::size_t i = 0; i < DataSize; i++)
+        {
+            x = (x * 1664525U) + 1013904223U;
+            integers[i] = x;
+            floats_a[i] = float(x >> 8U) * 1e-3F;
+            floats_b[i] = floats_a[i] * (1.0F + (float((x >> 4U) & 15U) * 1e-7F));
+        }
+        bench::forgetValue(integers);
+        bench::forgetValue(floats_a);
+        bench::forgetValue(floats_b);
+    }
+};
+
+void benchmarkString()
+{
+    String<128> s;
+    String<32> first("Hello");
+    String<32> second("world");
+    bench::forgetValue(first);
+    bench::forgetValue(second);
+
+    bench::run("String.append", [&](std::size_t) {
+        s.clear();
+        s += first;
+        s += ", ";
+        s += second;
+        s += '!';
+        bench::doNotOptimize(s);
+    });
+    bench::run("String.concatenate", [&](std::size_t) {
+        s = first + ", " + second + "!";
+        bench::doNotOptimize(s);
+    });
+
+    String<64> a("The quick brown fox jumps over the lazy dog; the quick brown fox");
+    String<64> b(a);
+    String<64> c(a.toUpperCase());
+    bench::forgetValue(a);
+    bench::forgetValue(b);
+    bench::forgetValue(c);
+    bench::run("String.compare.equal", [&](std::size_t) { bench::doNotOptimize(a == b); });
+    bench::run("String.compare.cstr", [&](std::size_t) { bench::doNotOptimize(a == "The quick brown fox jumps"); });
+    bench::run("String.compare.less", [&](std::size_t) { bench::doNotOptimize(a < c); });
+    bench::run("String.equalsIgnoreCase", [&](std::size_t) { bench::doNotOptimize(a.equalsIgnoreCase(c)); });
+    bench::run("String.makeUpperCase", [&](std::size_t i) {
+        if ((i & 1U) == 0)
+        {
+            b.makeUpperCase();
+        }
+        else
+        {
+            b.makeLowerCase();
+        }
+        bench::doNotOptimize(b);
+    });
+}
+
+template <std::uint8_t Radix>
+void benchmarkIntToString(const char* const name, const Inputs& in)
+{
+    bench::run(name, [&](const std::size_t i) {
+        const auto out = convertIntToString<Radix>(in.integers[i % DataSize]);
+        bench::doNotOptimize(out);
+    });
+}
+
+void benchmarkVector(const Inputs& in)
+{
+    Vector<std::uint32_t, DataSize> v;
+    bench::run("Vector.push_back", [&](const std::size_t i) {
+        if (v.size() == v.capacity())
+        {
+            v.clear();
+        }
+        v.push_back(in.integers[i % DataSize]);
+        bench::doNotOptimize(v);
+    });
+
+    Vector<std::uint32_t, 64> chunk(&in.integers[0], &in.integers[64]);
+    bench::run("Vector.append.64", [&](std::size_t) {
+        v.clear();
+        v.append(chunk);
+        v.append(chunk);
+        bench::doNotOptimize(v);
+    });
+
+    bench::run("Vector.resize.200", [&](std::size_t) {
+        v.resize(200);
+        bench::doNotOptimize(v);
+        v.resize(0);
+        bench::doNotOptimize(v);
+    });
+}
+
+void benchmarkComparison(const Inputs& in)
+{
+    bench::run("comparison.close.float", [&](const std::size_t i) {
+        bench::doNotOptimize(comparison::close(in.floats_a[i % DataSize], in.floats_b[i % DataSize]));
+    });
+    bench::run("comparison.close.double", [&](const std::size_t i) {
+        bench::doNotOptimize(comparison::close(double(in.floats_a[i % DataSize]),
+                                               double(in.floats_b[i % DataSize])));
+    });
+    bench::run("comparison.closeUlps.float", [&](const std::size_t i) {
+        bench::doNotOptimize(comparison::closeUlps<4>(in.floats_a[i % DataSize], in.floats_b[i % DataSize]));
+    });
+    bench::run("comparison.allClose.float.256", [&](std::size_t) {
+        bench::doNotOptimize(comparison::allClose(&in.floats_a[0], &in.floats_b[0], DataSize));
+    }, SENOVAL_BENCH_ITERATIONS / 10U);
+}
+
+void benchmarkSerialization(const Inputs& in)
+{
+    Vector<float, 24> state(&in.floats_a[0], &in.floats_a[24]);
+    std::uint8_t frame[128]{};
+    bench::run("serial.writeLengthPrefixed.float24", [&](std::size_t) {
+        serial::Writer<serial::ByteOrder::Little> w(frame);
+        (void) w.writeLengthPrefixed(state);
+        bench::doNotOptimize(frame);
+    });
+    bench::run("serial.writeLengthPrefixed.float24.swapped", [&](std::size_t) {
+        serial::Writer<serial::ByteOrder::Big> w(frame);
+        (void) w.writeLengthPrefixed(state);
+        bench::doNotOptimize(frame);
+    });
+    bench::run("serial.readLengthPrefixed.float24", [&](std::size_t) {
+        serial::Reader<serial::ByteOrder::Little> r(frame);
+        (void) r.readLengthPrefixed(state);
+        bench::doNotOptimize(state);
+    });
+}
+
+void benchmarkSnapshot(const Inputs& in)
+{
+    using State = Vector<float, 24>;
+    const State state(&in.floats_a[0], &in.floats_a[24]);
+    Snapshot<State> triple(state);
+    Snapshot<std::uint64_t> seqlock;
+    bench::run("Snapshot.TripleBuffer.store", [&](std::size_t) { triple.store(state); });
+    bench::run("Snapshot.TripleBuffer.load", [&](std::size_t) { bench::doNotOptimize(triple.load()); });
+    bench::run("Snapshot.SeqLock.store", [&](const std::size_t i) { seqlock.store(in.integers[i % DataSize]); });
+    bench::run("Snapshot.SeqLock.load", [&](std::size_t) { bench::doNotOptimize(seqlock.load()); });
+}
+
+}
+
+int main()
+{
+    bench::initCounter();
+    static const Inputs inputs;     // Static to keep it off the stack of small targets
+
+    benchmarkString();
+    benchmarkIntToString<2>("convertIntToString.radix2", inputs);
+    benchmarkIntToString<8>("convertIntToString.radix8", inputs);
+    benchmarkIntToString<10>("convertIntToString.radix10", inputs);
+    benchmarkIntToString<16>("convertIntToString.radix16", inputs);
+    benchmarkIntToString<36>("convertIntToString.radix36", inputs);
+    benchmarkVector(inputs);
+    benchmarkComparison(inputs);
+    benchmarkSerialization(inputs);
+    benchmarkSnapshot(inputs);
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// A dependency-free micro-benchmark harness that runs both on the host and on the target.
+// The results are printed as JSON Lines, one object per benchmark, for tracking across releases:
+//  {"benchmark":"String.append","counter":"tsc","iterations":10000,"min":12.34,"median":12.80}
+// The min and median are per operation, in the units of the counter: CPU cycles for "tsc" and "dwt",
+// nanoseconds for "ns".
+
+#pragma once
+
+#include <senoval/string.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__) || \
+      defined(__ARM_ARCH_8_1M_MAIN__)
+# define SENOVAL_BENCH_DWT 1
+#else
+# include <chrono>
+#endif
+
+/// The number of operations per sample; reduce it for slow targets.
+#ifndef SENOVAL_BENCH_ITERATIONS
+# define SENOVAL_BENCH_ITERATIONS 10000
+#endif
+
+namespace bench
+{
+/*
+ * The counter: the time stamp counter on x86, the DWT cycle counter on Cortex-M3 and above, std::chrono elsewhere.
+ * The DWT counter is 32-bit, so a sample shall not take longer than 2^32 cycles; the deltas are computed modulo that.
+ * ARMv6-M (Cortex-M0/M0+/M1) and ARMv8-M Baseline (Cortex-M23) have no DWT cycle counter; on those the std::chrono
+ * fallback is used, which is meaningless unless the platform implements steady_clock; check the "counter" field.
+ */
+#if defined(__x86_64__) || defined(__i386__)
+using Counter = std::uint64_t;
+constexpr const char* CounterName = "tsc";
+
+inline void initCounter() { }
+
+inline Counter readCounter() { return __rdtsc(); }
+#elif defined(SENOVAL_BENCH_DWT)
+using Counter = std::uint32_t;
+constexpr const char* CounterName = "dwt";
+
+inline void initCounter()
+{
+    auto& demcr    = *reinterpret_cast<volatile std::uint32_t*>(0xE000EDFCU);
+    auto& dwt_ctrl = *reinterpret_cast<volatile std::uint32_t*>(0xE0001000U);
+    auto& dwt_cyc  = *reinterpret_cast<volatile std::uint32_t*>(0xE0001004U);
+    auto& dwt_lar  = *reinterpret_cast<volatile std::uint32_t*>(0xE0001FB0U);
+    demcr = demcr | (1U << 24U);        // TRCENA
+    dwt_lar = 0xC5ACCE55U;              // Unlock the DWT; required on Cortex-M7, ignored where there is no lock
+    dwt_cyc = 0;
+    dwt_ctrl = dwt_ctrl | 1U;           // CYCCNTENA
+}
+
+inline Counter readCounter() { return *reinterpret_cast<volatile std::uint32_t*>(0xE0001004U); }
+#else
+using Counter = std::uint64_t;
+constexpr const char* CounterName = "ns";
+
+inline void initCounter() { }
+
+inline Counter readCounter()
+{
+    return Counter(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+
+/// Prevents the compiler from optimizing out the computation of the value.
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+    __asm__ __volatile__("" : : "m"(value) : "memory");
+#else
+    static volatile const void* sink = nullptr;
+    sink = &value;
+#endif
+}
+
+/// Prevents the compiler from assuming that the inputs are known.
+template <typename T>
+inline void forgetValue(T& value)
+{
+#if defined(__GNUC__)
+    __asm__ __volatile__("" : "+m"(value) : : "memory");
+#else
+    doNotOptimize(value);
+#endif
+}
+
+/// The output is written with std::puts(), which the target shall redirect to a serial port or to the debugger.
+inline void print(const char* const name, const Counter min, const Counter median, const std::size_t iterations)
+{
+    senoval::String<200> line("{\"benchmark\":\"");
+    line += name;
+    line += "\",\"counter\":\"";
+    line += CounterName;
+    line += "\",\"iterations\":";
+    line += senoval::convertIntToString(std::uint64_t(iterations));
+    // Fixed point with two decimals; printf() of floats is often not available on the target.
+    const auto append_per_op = [&line, iterations](const char* const key, const Counter total) {
+        const std::uint64_t hundredths = (std::uint64_t(total) * 100U) / iterations;
+        line += key;
+        line += senoval::convertIntToString(hundredths / 100U);
+        line += '.';
+        line += senoval::convertIntToString(std::uint8_t(hundredths % 100U), 2);
+    };
+    append_per_op(",\"min\":", min);
+    append_per_op(",\"median\":", median);
+    line += '}';
+    std::puts(line.c_str());
+}
+
+/**
+ * Invokes the body with the operation index for the specified number of iterations, repeatedly.
+ * The minimum is the best estimate of the cost; the median shows how noisy the environment is.
+ */
+template <typename F>
+inline void run(const char* const name, F&& body, const std::size_t iterations = SENOVAL_BENCH_ITERATIONS)
+{
+    constexpr std::size_t Samples = 15;
+    Counter deltas[Samples]{};
+    for (std::size_t i = 0; i < iterations; i++)    // Warm up the caches and the branch predictor
+    {
+        body(i);
+    }
+    for (auto& d : deltas)
+    {
+        const Counter started = readCounter();
+        for (std::size_t i = 0; i < iterations; i++)
+        {
+            body(i);
+        }
+        d = Counter(readCounter() - started);
+    }
+    std::sort(&deltas[0], &deltas[Samples]);
+    print(name, deltas[0], deltas[Samples / 2U], iterations);
+}
+
+}
@@ -0,0 +1,131 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/arena.hpp>
+
+// Test-only dependencies
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <string>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+TEST_CASE("Arena")
+{
+    Arena<256> arena;
+    REQUIRE(arena.capacity() == 256);
+    REQUIRE(arena.empty());
+
+    auto* const a = static_cast<std::uint8_t*>(arena.allocate(3, 1));
+    REQUIRE(a != nullptr);
+    REQUIRE(arena.size() == 3);
+    REQUIRE(arena.owns(a));
+
+    auto* const b = arena.construct<std::uint64_t>(123U);
+    REQUIRE(b != nullptr);
+    REQUIRE(*b == 123U);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(b) % alignof(std::uint64_t)) == 0);
+    REQUIRE(arena.size() == 16);            // 3 + 5 padding + 8
+
+    const auto mark = arena.getMark();
+    void* const big = arena.allocate(64, 64);
+    REQUIRE(big != nullptr);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(big) % 64U) == 0);
+    REQUIRE(arena.allocate(1000) == nullptr);
+    REQUIRE(arena.getHighWatermark() == arena.size());
+    const std::size_t peak = arena.size();
+
+    arena.rewind(mark);
+    REQUIRE(arena.size() == 16);
+    REQUIRE(arena.allocate(8) == static_cast<void*>(b + 1));     // Reused
+    REQUIRE(arena.getHighWatermark() == peak);
+
+    // Fill up exactly
+    arena.reset();
+    REQUIRE(arena.empty());
+    REQUIRE(arena.allocate(256, 1) != nullptr);
+    REQUIRE(arena.allocate(1, 1) == nullptr);
+    REQUIRE(arena.allocate(0, 1) != nullptr);
+    arena.reset();
+    REQUIRE(arena.allocate(257, 1) == nullptr);
+    REQUIRE(arena.empty());
+    REQUIRE(!arena.owns(&arena + 1));
+}
+
+#if defined(__cpp_lib_memory_resource)
+TEST_CASE("ArenaResource")
+{
+    Arena<4096> arena;
+    {
+        ArenaResource resource(arena);
+        std::pmr::vector<int> vec(&resource);
+        for (int i = 0; i < 100; i++)
+        {
+            vec.push_back(i);
+        }
+        REQUIRE(vec.size() == 100);
+        REQUIRE(vec[99] == 99);
+        REQUIRE(arena.owns(vec.data()));
+        REQUIRE(arena.size() > 100 * sizeof(int));
+
+        // The global heap is not touched when the arena is exhausted
+        std::pmr::vector<char> huge(&resource);
+        bool thrown = false;
+        try
+        {
+            huge.resize(10000);
+        }
+        catch (const std::bad_alloc&)
+        {
+            thrown = true;
+        }
+        REQUIRE(thrown);
+    }
+    arena.reset();
+
+    // Or it can fall back to another resource
+    ArenaResource resource(arena, std::pmr::new_delete_resource());
+    std::pmr::string str("a string that is long enough to not fit into the small buffer", &resource);
+    REQUIRE(arena.owns(str.data()));
+    std::pmr::vector<char> huge(10000, 'x', &resource);
+    REQUIRE(!arena.owns(huge.data()));
+    REQUIRE(huge.back() == 'x');
+}
+#endif
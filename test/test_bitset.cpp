@@ -0,0 +1,171 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+#include <senoval/bitset.hpp>
+
+// Test-only dependencies
+#include <bitset>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+static_assert(Bitset<10>(0x3FFU).all());
+static_assert(Bitset<10>(0xFFFFU).count() == 10);
+static_assert(Bitset<100>(0b1010'0000U).findFirst() == 5);
+static_assert(Bitset<100>(0b1010'0000U).findNext(5) == 7);
+static_assert(Bitset<100>(0b1010'0000U).findLast() == 7);
+static_assert(Bitset<100>().set(99).findLast() == 99);
+static_assert(Bitset<100>().set().findFirstClear() == Bitset<100>::npos);
+static_assert((~Bitset<70>()).count() == 70);
+
+
+TEST_CASE("BitsetBasic")
+{
+    Bitset<70> b;
+    REQUIRE(b.size() == 70);
+    REQUIRE(b.none());
+    REQUIRE(!b.any());
+    REQUIRE(b.count() == 0);
+    REQUIRE(b.findFirst() == b.npos);
+    REQUIRE(b.findLast() == b.npos);
+    REQUIRE(b.findNext(0) == b.npos);
+    REQUIRE(b.findFirstClear() == 0);
+
+    b.set(0).set(63).set(64).set(69);
+    REQUIRE(b.count() == 4);
+    REQUIRE(b.test(63));
+    REQUIRE(b[64]);
+    REQUIRE(!b[65]);
+    REQUIRE(b.findFirst() == 0);
+    REQUIRE(b.findNext(0) == 63);
+    REQUIRE(b.findNext(63) == 64);
+    REQUIRE(b.findNext(64) == 69);
+    REQUIRE(b.findNext(69) == b.npos);
+    REQUIRE(b.findLast() == 69);
+    REQUIRE(b.findFirstClear() == 1);
+
+    b.reset(0).flip(1).set(63, false);
+    REQUIRE(b.findFirst() == 1);
+    REQUIRE(b.count() == 3);
+    REQUIRE(b.to_ullong() == 0b10U);
+
+    b.flip();
+    REQUIRE(b.count() == 67);
+    REQUIRE(b.findFirstClear() == 1);
+    b.set();
+    REQUIRE(b.all());
+    REQUIRE(b.findFirstClear() == b.npos);
+    REQUIRE((~b).none());
+    b.reset();
+    REQUIRE(b.none());
+
+    const Bitset<70> x(0b1100U);
+    const Bitset<70> y(0b1010U);
+    REQUIRE((x & y) == Bitset<70>(0b1000U));
+    REQUIRE((x | y) == Bitset<70>(0b1110U));
+    REQUIRE((x ^ y) == Bitset<70>(0b0110U));
+    REQUIRE((x ^ y) != x);
+    REQUIRE((x | y).contains(x));
+    REQUIRE(!x.contains(y));
+
+    // The empty set stays empty whatever is done to it
+    Bitset<0> e;
+    e.set();
+    REQUIRE(e.count() == 0);
+    REQUIRE(e.all());
+    REQUIRE(e.none());
+    e.flip();
+    REQUIRE(e.count() == 0);
+    REQUIRE(e == Bitset<0>());
+    REQUIRE(e.findFirst() == e.npos);
+}
+
+TEST_CASE("BitsetRandomized")
+{
+    std::mt19937 rng(42);
+    constexpr std::size_t N = 301;
+    for (int iter = 0; iter < 100; iter++)
+    {
+        Bitset<N> a;
+        Bitset<N> b;
+        std::bitset<N> ra;
+        std::bitset<N> rb;
+        const std::size_t density = 1U + (rng() % 50U);
+        for (std::size_t i = 0; i < N; i++)
+        {
+            if ((rng() % 100U) < density)
+            {
+                a.set(i);
+                ra.set(i);
+            }
+            if ((rng() % 100U) < density)
+            {
+                b.set(i);
+                rb.set(i);
+            }
+        }
+
+        REQUIRE(a.count() == ra.count());
+        REQUIRE(a.any() == ra.any());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < N; i++)
+        {
+            if (ra.test(i))
+            {
+                expected.push_back(i);
+            }
+        }
+        std::vector<std::size_t> actual;
+        for (auto i = a.findFirst(); i < a.size(); i = a.findNext(i))
+        {
+            actual.push_back(i);
+        }
+        REQUIRE(actual == expected);
+        REQUIRE(a.findLast() == (expected.empty() ? a.npos : expected.back()));
+
+        const auto check = [](const Bitset<N>& x, const std::bitset<N>& rx)
+        {
+            for (std::size_t i = 0; i < N; i++)
+            {
+                REQUIRE(x.test(i) == rx.test(i));
+            }
+            REQUIRE(x.count() == rx.count());
+        };
+        check(a & b, ra & rb);
+        check(a | b, ra | rb);
+        check(a ^ b, ra ^ rb);
+        check(~a, ~ra);
+    }
+}
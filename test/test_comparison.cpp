@@ -36,6 +36,8 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <random>
+#include <senoval/vector.hpp>
 
 // Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
 // that slows things down.
@@ -72,3 +74,239 @@ TEST_CASE("Comparison")
     REQUIRE(!positive(0));
     REQUIRE(!negative(0));
 }
+
+
+template <typename T>
+static void testBatch(const std::uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    const T special[] = {
+        T(0), -T(0), T(1), -T(1),
+        std::numeric_limits<T>::infinity(), -std::numeric_limits<T>::infinity(),
+        std::numeric_limits<T>::quiet_NaN(),
+        std::numeric_limits<T>::max(), -std::numeric_limits<T>::max(),
+        std::numeric_limits<T>::min(), std::numeric_limits<T>::denorm_min(),
+        std::numeric_limits<T>::epsilon(),
+    };
+    constexpr std::size_t Size = 1000;
+    static T a[Size];
+    static T b[Size];
+    static bool mask[Size];
+    for (int iteration = 0; iteration < 20; iteration++)
+    {
+        std::uniform_real_distribution<T> dist(T(-10), T(10));
+        for (std::size_t i = 0; i < Size; i++)
+        {
+            const auto kind = rng() % 8U;
+            a[i] = (kind == 0) ? special[rng() % std::size(special)] : dist(rng);
+            b[i] = (kind == 0) ? special[rng() % std::size(special)] :
+                   (kind == 1) ? dist(rng) :
+                   (kind == 2) ? (a[i] * (T(1) + std::numeric_limits<T>::epsilon() * T(rng() % 30U))) :
+                   (kind == 3) ? (a[i] + std::numeric_limits<T>::epsilon() * T(rng() % 3U)) :
+                   a[i];
+        }
+        std::size_t expected_first = Size;
+        std::size_t expected_mismatches = 0;
+        for (std::size_t i = 0; i < Size; i++)
+        {
+            const bool c = close(a[i], b[i]);
+            if (!c)
+            {
+                expected_first = std::min(expected_first, i);
+                expected_mismatches++;
+            }
+            REQUIRE(detail::closeBranchFree(a[i], b[i],
+                                            DefaultTolerance::getAbsoluteEpsilon<T>(),
+                                            DefaultTolerance::getRelativeEpsilon<T>()) == c);
+        }
+        REQUIRE(closeMask(a, b, mask) == expected_mismatches);
+        for (std::size_t i = 0; i < Size; i++)
+        {
+            REQUIRE(mask[i] == close(a[i], b[i]));
+        }
+        REQUIRE(firstMismatch(a, b) == expected_first);
+        REQUIRE(allClose(a, b) == (expected_mismatches == 0));
+
+        // All suffixes of a mismatching array
+        for (std::size_t offset = 0; offset < 40; offset++)
+        {
+            const std::size_t first = firstMismatch(a + offset, b + offset, Size - offset);
+            std::size_t expected = Size - offset;
+            for (std::size_t i = offset; i < Size; i++)
+            {
+                if (!close(a[i], b[i]))
+                {
+                    expected = i - offset;
+                    break;
+                }
+            }
+            REQUIRE(first == expected);
+        }
+    }
+}
+
+TEST_CASE("ComparisonBatch")
+{
+    testBatch<float>(1);
+    testBatch<double>(2);
+    testBatch<long double>(3);
+
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    const senoval::Vector<float, 10> x{1.0F, 2.0F, inf, -inf, 0.0F, 1e-9F};
+    senoval::Vector<float, 10> y{1.0F, 2.0F, inf, -inf, -0.0F, 0.0F};
+    REQUIRE(allClose(x, y));
+    REQUIRE(firstMismatch(x, y) == 6);
+    y.push_back(1.0F);
+    REQUIRE(!allClose(x, y));
+    REQUIRE(firstMismatch(x, y) == 6);      // Common prefix
+    y.pop_back();
+
+    y[3] = inf;
+    y[5] = nan;
+    bool mask[6]{};
+    REQUIRE(closeMask(x, y, mask) == 2);
+    REQUIRE(mask[0]);
+    REQUIRE(mask[2]);
+    REQUIRE(!mask[3]);
+    REQUIRE(mask[4]);
+    REQUIRE(!mask[5]);
+    REQUIRE(firstMismatch(x, y) == 3);
+    REQUIRE(!allClose(x.data(), y.data(), x.size()));
+    REQUIRE(allClose(x.data(), y.data(), 3));
+    REQUIRE(allClose(x.data(), y.data(), x.size(), 10.0F, 0.0F) == false);     // Inf vs -Inf is never close
+
+    const double p[] = {1.0, 1.5};
+    const double q[] = {1.2, 1.0};
+    REQUIRE(firstMismatch(p, q, 2, 0.3, 0.0) == 1);
+    REQUIRE(allClose(p, q, 2, 0.0, 0.5));
+    REQUIRE(!allClose(p, q));
+}
+
+static_assert(ulpDistance(1.0F, 1.0F) == 0);
+static_assert(ulpDistance(0.0F, -0.0F) == 0);
+static_assert(ulpDistance(1.0F, 1.0F + std::numeric_limits<float>::epsilon()) == 1);
+static_assert(ulpDistance(-std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::denorm_min()) == 2);
+static_assert(ulpDistance(std::numeric_limits<double>::max(), std::numeric_limits<double>::infinity()) == 1);
+static_assert(ulpDistance(1.0, std::numeric_limits<double>::quiet_NaN()) == UINT64_MAX);
+static_assert(closeUlps<4>(0.1 + 0.2, 0.3));
+static_assert(!closeUlps<0>(0.1 + 0.2, 0.3));
+static_assert(close(1.0F, 1.0F + std::numeric_limits<float>::epsilon(), Ulps<1>()));
+static_assert(closeToZero(-0.0, Ulps<0>()));
+static_assert(!closeToZero(1e-300, Ulps<1000>()));
+
+TEST_CASE("ComparisonUlps")
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    REQUIRE(closeUlps<0>(inf, inf));
+    REQUIRE(!closeUlps<10>(inf, -inf));
+    REQUIRE(!closeUlps<10>(inf, std::numeric_limits<float>::max()));
+    REQUIRE(!closeUlps<10>(nan, nan));
+    REQUIRE(!closeUlps<10>(nan, 1.0F));
+    REQUIRE(ulpDistance(nan, nan) == UINT32_MAX);
+    REQUIRE(ulpDistance(-1.0F, 1.0F) == 2U * ulpDistance(0.0F, 1.0F));
+
+    // Walk with nextafter() from random starting points
+    std::mt19937 rng(123);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (int i = 0; i < 1000; i++)
+    {
+        const double start = (i % 2 == 0) ? dist(rng) : (dist(rng) * 1e-310);   // Normal and subnormal
+        const std::uint64_t steps = rng() % 20U;
+        double x = start;
+        for (std::uint64_t k = 0; k < steps; k++)
+        {
+            x = std::nextafter(x, std::numeric_limits<double>::infinity());
+        }
+        REQUIRE(ulpDistance(start, x) == steps);
+        REQUIRE(ulpDistance(x, start) == steps);
+        REQUIRE(closeUlps<19>(start, x));
+        REQUIRE(closeUlps<4>(start, x) == (steps <= 4));
+
+        const float fstart = float(start);
+        float fx = fstart;
+        for (std::uint64_t k = 0; k < steps; k++)
+        {
+            fx = std::nextafter(fx, -inf);
+        }
+        REQUIRE(ulpDistance(fstart, fx) == steps);
+        REQUIRE(close(fx, fstart, Ulps<19>()));
+    }
+}
+
+// Compile-time policies; the ULP-only ones are usable in constant expressions
+static_assert(close<Ulps<4>>(0.1 + 0.2, 0.3));
+static_assert(close<Ulps<4>>(0.1F, 0.1));
+static_assert(!close<Ulps<0>>(0.1 + 0.2, 0.3));
+static_assert(closeToZero<Ulps<0>>(-0.0F));
+static_assert(positive<Ulps<1>>(1e-30));
+static_assert(!positive<Ulps<1>>(std::numeric_limits<double>::denorm_min()));
+static_assert(negative<Ulps<1>>(-1.0F));
+static_assert(close<Ulps<0>>(3, 3));
+static_assert(!close<Ulps<0>>(3, 3.5));
+static_assert(detail::IsTolerance<DefaultTolerance>::value);
+static_assert(!detail::IsTolerance<float>::value);
+
+struct CustomTolerance
+{
+    static constexpr unsigned MaxUlps = 0;
+    template <typename T> static constexpr T getAbsoluteEpsilon() { return T(0.5); }
+    template <typename T> static constexpr T getRelativeEpsilon() { return T(0); }
+};
+
+TEST_CASE("ComparisonTolerance")
+{
+    REQUIRE(DefaultEpsilonMultiplier == 10);
+    using Loose = Tolerance<1, 1000>;
+    const float eps = std::numeric_limits<float>::epsilon();
+
+    // The default tolerance is the same as the overloads without a policy
+    REQUIRE(close<DefaultTolerance>(1.0F, 1.0F + eps * 9));
+    REQUIRE(close(1.0F, 1.0F + eps * 9));
+    REQUIRE(!close<DefaultTolerance>(1.0F, 1.0F + eps * 12));
+    REQUIRE(!close(1.0F, 1.0F + eps * 12));
+    REQUIRE(close<Loose>(1.0F, 1.0F + eps * 12));
+    REQUIRE(close(1.0F, 1.0F + eps * 12, Loose()));
+    REQUIRE(close<Loose>(1.0F, 1.0 + double(eps) * 12));           // Coerced to float
+    REQUIRE(!close<Loose>(1.0F, 1.01F));
+    REQUIRE(close<CustomTolerance>(1.0, 1.4));
+    REQUIRE(!close<CustomTolerance>(1.0, 1.6));
+    REQUIRE(closeToZero<CustomTolerance>(-0.4F));
+    REQUIRE(closeToZero(-0.4F, CustomTolerance()));
+    REQUIRE(closeToZero<CustomTolerance>(0));
+    REQUIRE(!closeToZero<CustomTolerance>(1));
+    REQUIRE(!positive<CustomTolerance>(0.4));
+    REQUIRE(positive<CustomTolerance>(0.6));
+    REQUIRE(!negative<CustomTolerance>(-0.4L));
+    REQUIRE(negative<CustomTolerance>(-0.6L));
+
+    // Epsilons or ULPs
+    using Either = Tolerance<0, 0, 3>;
+    using Both = Tolerance<1, 2, 3>;
+    REQUIRE(close<Either>(1.0F, 1.0F + eps * 3));
+    REQUIRE(!close<Either>(0.0F, eps));
+    REQUIRE(close<Both>(0.0F, eps));                                // Absolute
+    REQUIRE(close<Both>(1.0F, 1.0F + eps * 3));                     // ULPs
+    REQUIRE(!close<Both>(1.0F, 1.0F + eps * 4));
+    REQUIRE(close<Both>(std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity()));
+    REQUIRE(!close<Both>(std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::quiet_NaN()));
+
+    // Batch
+    const senoval::Vector<float, 10> x{1.0F, 2.0F, 3.0F, 4.0F};
+    const senoval::Vector<float, 10> y{1.0F, 2.0F + eps * 40, 3.0F, 4.5F};
+    REQUIRE(firstMismatch(x, y) == 1);
+    REQUIRE(firstMismatch<Loose>(x, y) == 3);
+    REQUIRE(firstMismatch<CustomTolerance>(x, y) == 4);
+    REQUIRE(firstMismatch<Ulps<40>>(x, y) == 3);
+    REQUIRE(firstMismatch<Ulps<40>>(x.data(), y.data(), 3) == 3);
+    REQUIRE(allClose<CustomTolerance>(x, y));
+    REQUIRE(allClose<CustomTolerance>(x.data(), y.data(), x.size()));
+    REQUIRE(!allClose<Loose>(x, y));
+    bool mask[4]{};
+    REQUIRE(closeMask<Loose>(x, y, mask) == 1);
+    REQUIRE(mask[1]);
+    REQUIRE(!mask[3]);
+    REQUIRE(closeMask<Both>(x.data(), y.data(), 4, mask) == 2);
+    REQUIRE(!mask[1]);
+}
@@ -0,0 +1,192 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/flat_map.hpp>
+
+// Test-only dependencies
+#include <senoval/string.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+TEST_CASE("StringOrdering")
+{
+    static_assert(String<8>("abc") < String<4>("abd"));
+    static_assert(String<8>("ab") < "abc");
+    static_assert("abc" > String<8>("ab"));
+    static_assert(String<8>("abc") <= StringView("abc"));
+    static_assert(String<8>("abc") >= "abc");
+    static_assert(!(String<8>("b") < "a"));
+    static_assert(String<8>("") < "a");
+}
+
+
+TEST_CASE("FlatMap")
+{
+    FlatMap<String<16>, float, 8> map{{"motor.kp", 1.0F}, {"motor.ki", 0.1F}, {"motor.kd", 0.0F}};
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.begin()->key == "motor.kd");        // Sorted
+    REQUIRE((map.end() - 1)->key == "motor.kp");
+    REQUIRE(map.find("motor.ki")->value == Approx(0.1F));
+    REQUIRE(map.find(StringView("motor.k")) == map.end());
+    REQUIRE(map.lower_bound("motor.k")->key == "motor.kd");
+    REQUIRE(map.lower_bound("z") == map.end());
+    REQUIRE(map.contains(String<32>("motor.kp")));
+    REQUIRE(map.count("motor") == 0);
+
+    *map.get("motor.kd") = 5.0F;
+    REQUIRE(*map.get("motor.kd") == Approx(5.0F));
+    REQUIRE(map.get("none") == nullptr);
+
+    REQUIRE(map.try_emplace("enabled", 1.0F).second);
+    REQUIRE(!map.try_emplace("enabled", 2.0F).second);
+    REQUIRE(map.insert({String<16>("zeta"), 3.0F}).second);
+    REQUIRE(map.insert_or_assign("enabled", 4.0F).first->value == Approx(4.0F));
+    REQUIRE(map.size() == 5);
+    REQUIRE(map.begin()->key == "enabled");
+    REQUIRE(std::is_sorted(map.begin(), map.end(), [](const auto& a, const auto& b) { return a.key < b.key; }));
+
+    REQUIRE(map.erase("motor.ki") == 1);
+    REQUIRE(map.erase("motor.ki") == 0);
+    REQUIRE(map.erase(map.begin())->key == "motor.kd");
+    REQUIRE(map.size() == 3);
+
+    // Duplicates are dropped when building
+    FlatMap<int, int, 4> small;
+    const FlatMap<int, int, 4>::Entry raw[] = {{3, 0}, {1, 0}, {3, 0}, {2, 0}, {0, 0}, {1, 0}};
+    REQUIRE(small.buildFromUnsorted(std::begin(raw), std::end(raw)));
+    REQUIRE(small.size() == 4);         // The duplicates do not take up room, so the keys past the capacity fit
+    REQUIRE(small.begin()->key == 0);
+    REQUIRE(small.contains(2));
+
+    // The first distinct keys are kept if there are more than the capacity
+    const FlatMap<int, int, 4>::Entry many[] = {{9, 0}, {9, 1}, {7, 0}, {9, 2}, {8, 0}, {7, 1}, {5, 0}, {6, 0}, {9, 3}};
+    REQUIRE(!small.buildFromUnsorted(std::begin(many), std::end(many)));
+    REQUIRE(small.size() == 4);
+    REQUIRE(small.begin()->key == 5);
+    REQUIRE(!small.contains(6));
+    REQUIRE(small.contains(9));
+    for (int i = 0; i < 10; i++)
+    {
+        (void) small.try_emplace(i, i);
+    }
+    REQUIRE(small.size() == 4);
+    REQUIRE(!small.try_emplace(100, 0).second);
+    REQUIRE(small.try_emplace(100, 0).first == small.end());
+}
+
+
+TEST_CASE("FlatMapRandomized")
+{
+    static_assert(std::is_trivially_copyable_v<FlatMap<std::uint32_t, std::uint32_t, 4>::Entry>);
+
+    // Large enough for prefetching
+    static constexpr std::size_t Capacity = 2000;
+    FlatMap<std::uint32_t, std::uint32_t, Capacity> map;
+    std::map<std::uint32_t, std::uint32_t> ref;
+    std::mt19937 rng(42);       // NOLINT
+    std::vector<FlatMap<std::uint32_t, std::uint32_t, Capacity>::Entry> initial;
+    for (std::size_t i = 0; i < 1000; i++)
+    {
+        const auto key = std::uint32_t(rng() % 5000U);
+        initial.push_back({key, key * 3U});
+        ref.emplace(key, key * 3U);
+    }
+    map.buildFromUnsorted(initial.begin(), initial.end());
+    REQUIRE(map.size() == ref.size());
+
+    for (int i = 0; i < 20000; i++)
+    {
+        const auto key = std::uint32_t(rng() % 5000U);
+        if ((rng() % 2U) == 0)
+        {
+            REQUIRE(map.erase(key) == ref.erase(key));
+        }
+        else if (ref.size() < Capacity)
+        {
+            REQUIRE(map.try_emplace(key, key * 3U).second == ref.emplace(key, key * 3U).second);
+        }
+        const auto probe = std::uint32_t(rng() % 5000U);
+        const auto it = ref.lower_bound(probe);
+        const auto mine = map.lower_bound(probe);
+        REQUIRE((it == ref.end()) == (mine == map.end()));
+        if (mine != map.end())
+        {
+            REQUIRE(mine->key == it->first);
+            REQUIRE(mine->value == it->second);
+        }
+    }
+    REQUIRE(std::equal(map.begin(), map.end(), ref.begin(), ref.end(),
+                       [](const auto& a, const auto& b) { return (a.key == b.first) && (a.value == b.second); }));
+}
+
+
+TEST_CASE("FlatSet")
+{
+    FlatSet<int, 6> set{5, 1, 3, 3, 5};
+    REQUIRE(set.size() == 3);
+    REQUIRE(std::is_sorted(set.begin(), set.end()));
+    REQUIRE(set.contains(3));
+    REQUIRE(!set.contains(2));
+    REQUIRE(*set.lower_bound(2) == 3);
+    REQUIRE(set.insert(2).second);
+    REQUIRE(!set.insert(2).second);
+    REQUIRE(*set.insert(0).first == 0);
+    REQUIRE(set.insert(9).second);
+    REQUIRE(set.size() == 6);
+    REQUIRE(!set.insert(7).second);
+    REQUIRE(set.erase(3) == 1);
+    REQUIRE(set.erase(3) == 0);
+
+    const int expected[] = {0, 1, 2, 5, 9};
+    REQUIRE(std::equal(set.begin(), set.end(), std::begin(expected), std::end(expected)));
+
+    const int repeated[] = {4, 4, 4, 4, 4, 4, 4, 2, 4, 8};
+    REQUIRE(set.buildFromUnsorted(std::begin(repeated), std::end(repeated)));
+    REQUIRE(set.size() == 3);
+
+    FlatSet<String<8>, 4> names{"b", "a", "c"};
+    REQUIRE(names.contains("a"));
+    REQUIRE(names.find(StringView("c")) == names.end() - 1);
+    REQUIRE(*names.begin() == "a");
+}
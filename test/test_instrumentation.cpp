@@ -0,0 +1,145 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+// This file is built into a separate executable, since all translation units shall agree on the setting.
+#define SENOVAL_INSTRUMENTATION 1
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/instrumentation.hpp>
+
+// Test-only dependencies
+#include <senoval/string.hpp>
+#include <senoval/vector.hpp>
+#include <cstdint>
+#include <cstring>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+static constexpr String<8> makeCounted()
+{
+    String<8> s("abc");
+    s += "defghijk";    // Truncated
+    return s;
+}
+
+static void ignoreOverflow(const OverflowKind) { }
+
+static std::size_t getRecordCount()
+{
+    std::size_t count = 0;
+    for (auto r = instrumentation::Record::getFirst(); r != nullptr; r = r->getNext())
+    {
+        count++;
+    }
+    return count;
+}
+
+TEST_CASE("InstrumentationString")
+{
+    // Still works in constant expressions; the registry is not involved
+    static_assert(makeCounted().getStatistics().peak_size == 8);
+    static_assert(makeCounted().getStatistics().overflow_count == 1);
+    constexpr String<8> compile_time = makeCounted();
+    static_assert(String<8>(compile_time).toUpperCase() == "ABCDEFGH");
+
+    using S = String<16, overflow::TruncateAndCount>;
+    const std::size_t records_before = getRecordCount();
+    S a("Hello");
+    REQUIRE(getRecordCount() == records_before + 1U);
+    REQUIRE(a.getStatistics().peak_size == 5);
+    a += ", world";
+    a.clear();
+    a += '!';
+    REQUIRE(a.getStatistics().peak_size == 12);
+    REQUIRE(a.getStatistics().overflow_count == 0);
+    a.resize(20);
+    REQUIRE(a.size() == 16);
+    REQUIRE(a.getStatistics().peak_size == 16);
+    REQUIRE(a.getStatistics().overflow_count == 1);
+    REQUIRE(a.getOverflowPolicy().getCount() == 1);
+
+    S b("x");
+    b.push_back('y');
+    const auto& record = instrumentation::getRecord<S>();
+    REQUIRE(getRecordCount() == records_before + 1U);   // Same type, same record
+    REQUIRE(record.getCapacity() == 16);
+    REQUIRE(record.getFootprint() == sizeof(S));
+    REQUIRE(record.getStatistics().peak_size == 16);
+    REQUIRE(record.getStatistics().overflow_count == 1);
+    REQUIRE(b.getStatistics().peak_size == 2);
+    if (record.getSignature() != nullptr)
+    {
+        REQUIRE(std::strstr(record.getSignature(), "String") != nullptr);
+    }
+
+    b.resetStatistics();
+    REQUIRE(b.getStatistics().peak_size == 0);
+    instrumentation::getRecord<S>().resetStatistics();
+    REQUIRE(record.getStatistics().peak_size == 0);
+}
+
+TEST_CASE("InstrumentationVector")
+{
+    using V = Vector<std::uint16_t, 4>;
+    V vec{1, 2};
+    vec.push_back(3);
+    vec.pop_back();
+    vec.append(V{4});
+    REQUIRE(vec.getStatistics().peak_size == 3);
+    vec.insert(vec.begin(), {5, 6, 7});     // Truncated
+    REQUIRE(vec.size() == 4);
+    REQUIRE(vec.getStatistics().peak_size == 4);
+    REQUIRE(vec.getStatistics().overflow_count == 1);
+
+    const V& cvec = vec;
+    (void) cvec.front();
+    REQUIRE(cvec.getStatistics().overflow_count == 1);
+
+    const auto& record = instrumentation::getRecord<V>();
+    REQUIRE(record.getCapacity() == 4);
+    REQUIRE(record.getStatistics().peak_size == 4);
+    REQUIRE(record.getStatistics().overflow_count == 1);
+
+    // Only the record of the type knows about the events in const member functions
+    Vector<int, 2, overflow::Callback<&ignoreOverflow>> lenient;
+    const auto& clenient = lenient;
+    lenient.push_back(1);
+    lenient.push_back(2);
+    lenient.push_back(3);
+    REQUIRE(lenient.getStatistics().overflow_count == 1);
+    REQUIRE(clenient[5] == 2);
+    REQUIRE(lenient.getStatistics().overflow_count == 1);
+    REQUIRE(instrumentation::getRecord<decltype(lenient)>().getStatistics().overflow_count == 2);
+}
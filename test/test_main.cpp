@@ -31,4 +31,6 @@
 // For speedy compilation, the file that contains CATCH_CONFIG_MAIN should not contain any actual tests.
 // https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
 #define CATCH_CONFIG_MAIN
+// This version of Catch uses SIGSTKSZ as a constant expression, which is no longer the case since glibc 2.34.
+#define CATCH_CONFIG_NO_POSIX_SIGNALS
 #include "catch.hpp"  // NOLINT
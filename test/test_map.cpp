@@ -0,0 +1,226 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/map.hpp>
+
+// Test-only dependencies
+#include <senoval/string.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+TEST_CASE("Map")
+{
+    using Key = String<32>;
+    Map<Key, int, 4> map;
+    REQUIRE(map.empty());
+    REQUIRE(map.capacity() == 4);
+    REQUIRE(map.find("a") == map.end());
+    REQUIRE(map.begin() == map.end());
+
+    REQUIRE(map.try_emplace("motor.kp", 1).second);
+    REQUIRE(map.try_emplace(StringView("motor.ki"), 2).second);
+    REQUIRE(map.insert({Key("motor.kd"), 3}).second);
+    REQUIRE(!map.try_emplace(Key("motor.kp"), 100).second);   // Already exists, not modified
+    REQUIRE(map.size() == 3);
+
+    // Heterogeneous lookup
+    REQUIRE(map.find("motor.kp")->second == 1);
+    REQUIRE(map.find(StringView("motor.ki.extra", 8))->second == 2);
+    REQUIRE(map.find(String<8>("motor.kd"))->first == "motor.kd");
+    REQUIRE(map.find(std::string("motor.kd")) != map.end());
+    REQUIRE(map.contains("motor.kd"));
+    REQUIRE(!map.contains("motor"));
+    REQUIRE(map.count("motor.ki") == 1);
+    REQUIRE(*map.get("motor.ki") == 2);
+    REQUIRE(map.get("motor.k") == nullptr);
+
+    REQUIRE(map.insert_or_assign("motor.kp", 10).first->second == 10);
+    REQUIRE(map.insert_or_assign("enabled", 1).second);
+    REQUIRE(map.size() == 4);
+
+    // Full
+    const auto full = map.try_emplace("another", 0);
+    REQUIRE(!full.second);
+    REQUIRE(full.first == map.end());
+    REQUIRE(map.try_emplace("enabled", 0).first != map.end());
+
+    int sum = 0;
+    for (const auto& [key, value] : map)
+    {
+        REQUIRE(map.find(key)->second == value);
+        sum += value;
+    }
+    REQUIRE(sum == 16);
+
+    const auto copy = map;
+    REQUIRE(map.erase("motor.kp") == 1);
+    REQUIRE(map.erase("motor.kp") == 0);
+    REQUIRE(map.size() == 3);
+    REQUIRE(!map.contains("motor.kp"));
+    REQUIRE(copy.size() == 4);
+    REQUIRE(copy.get("motor.kp") != nullptr);
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.begin() == map.end());
+}
+
+
+TEST_CASE("MapRandomized")
+{
+    // The parameter registry use case, validated against the standard container
+    static constexpr std::size_t Capacity = 400;
+    Map<String<32>, std::uint32_t, Capacity> map;
+    std::unordered_map<std::string, std::uint32_t> ref;
+
+    std::mt19937 rng(42);   // NOLINT
+    const auto make_key = [&rng]() {
+        return "param." + std::to_string(rng() % 600U);
+    };
+    for (int i = 0; i < 100000; i++)
+    {
+        const std::string key = make_key();
+        const auto action = std::uint32_t(rng() % 3U);
+        if (action == 0)
+        {
+            REQUIRE(map.erase(key) == ref.erase(key));
+        }
+        else if (ref.size() < Capacity)
+        {
+            const auto value = std::uint32_t(rng());
+            const bool inserted = map.try_emplace(key.c_str(), value).second;
+            REQUIRE(inserted == ref.emplace(key, value).second);
+        }
+        else
+        {
+            REQUIRE(!map.try_emplace(key.c_str(), 0).second);
+        }
+        REQUIRE(map.size() == ref.size());
+
+        const std::string probe = make_key();
+        const auto it = ref.find(probe);
+        const auto* const value = map.get(probe.c_str());
+        REQUIRE((it == ref.end()) == (value == nullptr));
+        if (value != nullptr)
+        {
+            REQUIRE(*value == it->second);
+        }
+    }
+
+    std::size_t n = 0;
+    for (const auto& [key, value] : map)
+    {
+        REQUIRE(ref.at(std::string(key.c_str())) == value);
+        n++;
+    }
+    REQUIRE(n == ref.size());
+}
+
+
+TEST_CASE("MapNonTrivial")
+{
+    Map<int, std::unique_ptr<int>, 8> map;
+    for (int i = 0; i < 8; i++)
+    {
+        REQUIRE(map.try_emplace(i * 1024, std::make_unique<int>(i)).second);
+    }
+    REQUIRE(**map.get(3 * 1024) == 3);
+
+    auto moved = std::move(map);
+    REQUIRE(map.empty());                   // NOLINT
+    REQUIRE(moved.size() == 8);
+    for (int i = 0; i < 8; i += 2)
+    {
+        REQUIRE(moved.erase(i * 1024) == 1);
+    }
+    for (int i = 1; i < 8; i += 2)
+    {
+        REQUIRE(*moved.find(i * 1024)->second == i);
+    }
+    REQUIRE(moved.size() == 4);
+}
+
+
+namespace
+{
+/// All keys share one home slot, so the probe distances grow with every insertion.
+struct CollidingKey
+{
+    int value = 0;
+    bool operator==(const CollidingKey& other) const { return value == other.value; }
+};
+
+}
+
+template <>
+struct std::hash<CollidingKey>
+{
+    std::size_t operator()(const CollidingKey&) const { return 0; }
+};
+
+TEST_CASE("MapCollisions")
+{
+    // The distances exceed what a byte can hold
+    Map<CollidingKey, int, 300> map;
+    for (int i = 0; i < 300; i++)
+    {
+        REQUIRE(map.try_emplace(CollidingKey{i}, i).second);
+    }
+    REQUIRE(map.size() == 300);
+    REQUIRE(!map.try_emplace(CollidingKey{300}, 0).second);
+    for (int i = 0; i < 300; i++)
+    {
+        REQUIRE(*map.get(CollidingKey{i}) == i);
+    }
+    REQUIRE(!map.contains(CollidingKey{-1}));
+    for (int i = 0; i < 300; i += 2)
+    {
+        REQUIRE(map.erase(CollidingKey{i}) == 1);
+    }
+    for (int i = 1; i < 300; i += 2)
+    {
+        REQUIRE(*map.get(CollidingKey{i}) == i);
+    }
+    REQUIRE(map.size() == 150);
+}
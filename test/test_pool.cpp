@@ -0,0 +1,137 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/pool.hpp>
+
+// Test-only dependencies
+#include <senoval/string.hpp>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+namespace
+{
+struct Message
+{
+    static inline int live = 0;
+    String<16> text;
+    std::uint64_t timestamp = 0;
+
+    Message(const char* const t, const std::uint64_t ts) : text(t), timestamp(ts) { ++live; }
+    Message(const Message&) = delete;
+    Message& operator=(const Message&) = delete;
+    ~Message() { --live; }
+};
+}
+
+
+TEST_CASE("Pool")
+{
+    Pool<Message, 3> pool;
+    static_assert(sizeof(pool) <= (3 * sizeof(Message)) + alignof(Message));
+    REQUIRE(pool.empty());
+    REQUIRE(pool.capacity() == 3);
+    REQUIRE(pool.getHighWatermark() == 0);
+
+    Message* const a = pool.construct("a", 1U);
+    Message* const b = pool.construct("b", 2U);
+    REQUIRE(a != nullptr);
+    REQUIRE(b != nullptr);
+    REQUIRE(a != b);
+    REQUIRE(a->text == "a");
+    REQUIRE(b->timestamp == 2);
+    REQUIRE(pool.size() == 2);
+    REQUIRE(Message::live == 2);
+    REQUIRE(pool.owns(a));
+    const int local = 0;
+    REQUIRE(!pool.owns(&local));
+    REQUIRE(!pool.owns(reinterpret_cast<const unsigned char*>(a) + 1));   // NOLINT
+
+    pool.destroy(a);
+    REQUIRE(Message::live == 1);
+    REQUIRE(pool.size() == 1);
+    REQUIRE(pool.getHighWatermark() == 2);
+
+    // The freed block is reused first
+    Message* const c = pool.construct("c", 3U);
+    REQUIRE(c == a);
+    Message* const d = pool.construct("d", 4U);
+    REQUIRE(pool.full());
+    REQUIRE(pool.construct("e", 5U) == nullptr);
+    REQUIRE(pool.allocate() == nullptr);
+    REQUIRE(pool.getHighWatermark() == 3);
+
+    pool.destroy(b);
+    pool.destroy(c);
+    pool.destroy(d);
+    pool.destroy(nullptr);
+    REQUIRE(pool.empty());
+    REQUIRE(Message::live == 0);
+    REQUIRE(pool.getHighWatermark() == 3);
+}
+
+
+TEST_CASE("PoolRandomized")
+{
+    Pool<std::uint64_t, 100> pool;
+    std::vector<std::uint64_t*> live;
+    std::size_t max_live = 0;
+    std::mt19937 rng(42);   // NOLINT
+    for (std::uint64_t i = 0; i < 100000; i++)
+    {
+        if (((rng() % 3U) != 0) && (live.size() < 60))
+        {
+            auto* const p = pool.construct(i);
+            REQUIRE(p != nullptr);
+            REQUIRE(std::find(live.begin(), live.end(), p) == live.end());
+            live.push_back(p);
+        }
+        else if (!live.empty())
+        {
+            const std::size_t k = rng() % live.size();
+            pool.destroy(live[k]);
+            live.erase(live.begin() + std::ptrdiff_t(k));
+        }
+        max_live = std::max(max_live, live.size());
+        REQUIRE(pool.size() == live.size());
+        REQUIRE(pool.getHighWatermark() == max_live);
+    }
+}
@@ -0,0 +1,190 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/priority_queue.hpp>
+
+// Test-only dependencies
+#include <cstdlib>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+TEST_CASE("PriorityQueue")
+{
+    PriorityQueue<int, 5> pq;
+    REQUIRE(pq.empty());
+    REQUIRE(pq.capacity() == 5);
+    const auto h3 = pq.push(3);
+    const auto h1 = pq.push(1);
+    const auto h4 = pq.push(4);
+    REQUIRE(pq.size() == 3);
+    REQUIRE(pq.top() == 4);                 // Max-queue by default, like the standard one
+    REQUIRE(pq.topHandle() == h4);
+    REQUIRE(pq.get(h1) == 1);
+
+    pq.update(h1, 10);
+    REQUIRE(pq.top() == 10);
+    pq.update(h1, 0);
+    REQUIRE(pq.top() == 4);
+    pq.erase(h4);
+    REQUIRE(!pq.contains(h4));
+    REQUIRE(pq.contains(h3));
+    REQUIRE(pq.top() == 3);
+
+    (void) pq.push(7);
+    (void) pq.emplace(8);
+    (void) pq.push(5);
+    REQUIRE(pq.full());
+    REQUIRE(pq.top() == 8);
+
+    const int expected[] = {8, 7, 5, 3, 0};
+    for (const int x : expected)
+    {
+        REQUIRE(pq.top() == x);
+        pq.pop();
+    }
+    REQUIRE(pq.empty());
+    REQUIRE(!pq.contains(h1));
+    REQUIRE(!PriorityQueue<int, 5>::Handle().isValid());
+
+    // A stale handle does not alias the element that has reused its slot
+    const auto stale = pq.push(1);
+    pq.pop();
+    const auto fresh = pq.push(2);
+    REQUIRE(!pq.contains(stale));
+    REQUIRE(stale != fresh);
+    REQUIRE(pq.contains(fresh));
+    const auto cleared = pq.topHandle();
+    pq.clear();
+    REQUIRE(!pq.contains(cleared));
+    REQUIRE(pq.get(pq.push(3)) == 3);
+    REQUIRE(!pq.contains(cleared));
+
+    // Move-only values are released when removed
+    struct ByValue
+    {
+        bool operator()(const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const { return *a < *b; }
+    };
+    PriorityQueue<std::unique_ptr<int>, 2, ByValue> ptrs;
+    const auto p = ptrs.push(std::make_unique<int>(1));
+    (void) ptrs.push(std::make_unique<int>(2));
+    ptrs.update(p, std::make_unique<int>(3));
+    REQUIRE(*ptrs.top() == 3);
+    ptrs.pop();
+    REQUIRE(*ptrs.top() == 2);
+    ptrs.clear();
+    REQUIRE(ptrs.empty());
+}
+
+
+TEST_CASE("PriorityQueueRandomized")
+{
+    struct Timer
+    {
+        std::uint32_t deadline = 0;
+        std::uint32_t id = 0;
+        bool operator>(const Timer& other) const
+        {
+            return (deadline != other.deadline) ? (deadline > other.deadline) : (id > other.id);
+        }
+        bool operator<(const Timer& other) const { return other > *this; }
+    };
+
+    const auto run = [](auto& pq) {
+        using Handle = typename std::remove_reference_t<decltype(pq)>::Handle;
+        std::set<Timer> ref;
+        std::vector<std::pair<Handle, Timer>> handles;
+        std::mt19937 rng(42);                               // NOLINT
+        std::uint32_t next_id = 0;
+        for (int i = 0; i < 20000; i++)
+        {
+            const auto action = std::uint32_t(rng() % 4U);
+            if ((action == 0) && !pq.full())
+            {
+                const Timer t{std::uint32_t(rng() % 1000U), next_id++};
+                handles.emplace_back(pq.push(t), t);
+                ref.insert(t);
+            }
+            else if ((action == 1) && !pq.empty())
+            {
+                const Timer t = pq.top();
+                REQUIRE(t.id == ref.begin()->id);           // Earliest deadline first
+                ref.erase(ref.begin());
+                pq.pop();
+            }
+            else if (!handles.empty())
+            {
+                const std::size_t k = rng() % handles.size();
+                auto& [handle, timer] = handles[k];
+                if (!pq.contains(handle) || (pq.get(handle).id != timer.id))
+                {
+                    handles.erase(handles.begin() + std::ptrdiff_t(k));    // Stale
+                    continue;
+                }
+                ref.erase(timer);
+                if (action == 2)
+                {
+                    timer.deadline = std::uint32_t(rng() % 1000U);        // Reschedule
+                    pq.update(handle, timer);
+                    ref.insert(timer);
+                }
+                else
+                {
+                    pq.erase(handle);                                       // Cancel
+                    handles.erase(handles.begin() + std::ptrdiff_t(k));
+                }
+            }
+            REQUIRE(pq.size() == ref.size());
+            if (!pq.empty())
+            {
+                REQUIRE(pq.top().id == ref.begin()->id);
+            }
+        }
+    };
+
+    PriorityQueue<Timer, 64, std::greater<>> quaternary;
+    run(quaternary);
+    PriorityQueue<Timer, 64, std::greater<>, 2> binary;
+    run(binary);
+    PriorityQueue<Timer, 300, std::greater<>, 8> wide;
+    run(wide);
+}
@@ -0,0 +1,160 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/ring.hpp>
+
+// Test-only dependencies
+#include <cstdlib>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+TEST_CASE("RingBuffer")
+{
+    RingBuffer<std::int32_t, 4> rb;
+    REQUIRE(rb.capacity() == 4);
+    REQUIRE(rb.empty());
+    REQUIRE(!rb.full());
+
+    std::int32_t x = -1;
+    REQUIRE(!rb.pop(x));
+    REQUIRE(x == -1);
+
+    REQUIRE(rb.push(1));
+    REQUIRE(rb.push(2));
+    REQUIRE(rb.size() == 2);
+    REQUIRE(rb.pop(x));
+    REQUIRE(x == 1);
+
+    // Wrap around
+    const std::int32_t in[] = {3, 4, 5, 6, 7};
+    REQUIRE(rb.push(&in[0], 5) == 3);
+    REQUIRE(rb.full());
+    REQUIRE(!rb.push(8));
+
+    std::int32_t out[8]{};
+    REQUIRE(rb.pop(&out[0], 8) == 4);
+    REQUIRE(out[0] == 2);
+    REQUIRE(out[1] == 3);
+    REQUIRE(out[2] == 4);
+    REQUIRE(out[3] == 5);
+    REQUIRE(rb.empty());
+    REQUIRE(rb.pop(&out[0], 8) == 0);
+
+    REQUIRE(rb.push(&in[0], 2) == 2);
+    rb.clear();
+    REQUIRE(rb.empty());
+    REQUIRE(rb.push(&in[0], 4) == 4);
+    REQUIRE(rb.pop(&out[0], 1) == 1);
+    REQUIRE(out[0] == 3);
+
+    // Clearing after the consumer has cached the head: nothing is left to pop
+    {
+        RingBuffer<std::int32_t, 4> q;
+        REQUIRE(q.push(1));
+        std::int32_t x = 0;
+        REQUIRE(q.pop(x));
+        REQUIRE(q.push(&in[0], 3) == 3);
+        q.clear();
+        REQUIRE(!q.pop(x));
+        REQUIRE(q.size() == 0);
+        REQUIRE(q.empty());
+        REQUIRE(q.push(7));
+        REQUIRE(q.pop(x));
+        REQUIRE(x == 7);
+    }
+
+    // The indices of the two sides do not share a cache line on hosts
+    static_assert(sizeof(RingBuffer<std::uint8_t, 4>) >= 2 * SENOVAL_CACHE_LINE_SIZE);
+}
+
+
+TEST_CASE("RingBufferThreads")
+{
+    static constexpr std::uint32_t Count = 300000;
+    RingBuffer<std::uint32_t, 256> rb;
+
+    std::thread producer([&rb]() {
+        std::uint32_t next = 0;
+        std::uint32_t batch[7]{};
+        while (next < Count)
+        {
+            if ((next % 3) == 0)
+            {
+                next += rb.push(next) ? 1U : 0U;
+            }
+            else
+            {
+                std::size_t n = 0;
+                while ((n < 7) && ((next + n) < Count))
+                {
+                    batch[n] = next + std::uint32_t(n);
+                    n++;
+                }
+                next += std::uint32_t(rb.push(&batch[0], n));
+            }
+            if (rb.full())
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint32_t expected = 0;
+    bool in_order = true;
+    std::uint32_t buf[64]{};
+    while (expected < Count)
+    {
+        const std::size_t n = rb.pop(&buf[0], 1U + (expected % 64U));
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < n; i++)
+        {
+            in_order = in_order && (buf[i] == expected);
+            expected++;
+        }
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(rb.empty());
+}
@@ -0,0 +1,279 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/serial.hpp>
+
+// Test-only dependencies
+#include <senoval/string.hpp>
+#include <senoval/vector.hpp>
+#include <cstdint>
+#include <vector>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+using serial::ByteOrder;
+
+namespace
+{
+enum class Mode : std::uint16_t
+{
+    Idle = 1,
+    Armed = 0xABCD,
+};
+}
+
+template <std::size_t N>
+static std::vector<std::uint8_t> getBytes(const serial::Writer<ByteOrder::Little>& w, const std::uint8_t (&buf)[N])
+{
+    REQUIRE(w.data() == &buf[0]);
+    return std::vector<std::uint8_t>(&buf[0], &buf[0] + w.size());
+}
+
+TEST_CASE("SerialScalars")
+{
+    std::uint8_t buf[32]{};
+    {
+        serial::Writer<ByteOrder::Little> w(buf);
+        REQUIRE(w.write(std::uint16_t(0x1234)));
+        REQUIRE(w.write(std::int32_t(-2)));
+        REQUIRE(w.write(1.0F));
+        REQUIRE(w.write(Mode::Armed));
+        REQUIRE(w.write(true));
+        REQUIRE(w.skip(2));
+        REQUIRE(w.isOk());
+        REQUIRE(getBytes(w, buf) == std::vector<std::uint8_t>{0x34, 0x12,
+                                                              0xFE, 0xFF, 0xFF, 0xFF,
+                                                              0x00, 0x00, 0x80, 0x3F,
+                                                              0xCD, 0xAB,
+                                                              0x01,
+                                                              0x00, 0x00});
+        serial::Reader<ByteOrder::Little> r(buf, w.size());
+        std::uint16_t u16 = 0;
+        std::int32_t i32 = 0;
+        float f32 = 0;
+        Mode mode = Mode::Idle;
+        bool flag = false;
+        REQUIRE(r.read(u16));
+        REQUIRE(r.read(i32));
+        REQUIRE(r.read(f32));
+        REQUIRE(r.read(mode));
+        REQUIRE(r.read(flag));
+        REQUIRE(r.skip(2));
+        REQUIRE(r.getRemaining() == 0);
+        REQUIRE(u16 == 0x1234);
+        REQUIRE(i32 == -2);
+        REQUIRE(f32 == Approx(1.0F));
+        REQUIRE(mode == Mode::Armed);
+        REQUIRE(flag);
+        REQUIRE(!r.read(u16));          // Nothing left
+        REQUIRE(u16 == 0x1234);
+        REQUIRE(!r.isOk());
+    }
+    {
+        serial::Writer<ByteOrder::Big> w(buf);
+        REQUIRE(w.write(std::uint16_t(0x1234)));
+        REQUIRE(w.write(-1.5));
+        REQUIRE(w.size() == 10);
+        REQUIRE(buf[0] == 0x12);
+        REQUIRE(buf[1] == 0x34);
+        REQUIRE(buf[2] == 0xBF);
+        REQUIRE(buf[3] == 0xF8);
+        REQUIRE(buf[9] == 0x00);
+        serial::Reader<ByteOrder::Big> r(buf, w.size());
+        std::uint16_t u16 = 0;
+        double f64 = 0;
+        REQUIRE(r.read(u16));
+        REQUIRE(r.read(f64));
+        REQUIRE(u16 == 0x1234);
+        REQUIRE(f64 == Approx(-1.5));
+    }
+    buf[0] = 0x7F;      // Any nonzero byte is true
+    bool flag = false;
+    serial::Reader<> r(buf, 1);
+    REQUIRE(r.read(flag));
+    REQUIRE(flag);
+}
+
+TEST_CASE("SerialFailureIsSticky")
+{
+    std::uint8_t buf[5]{};
+    serial::Writer<> w(buf);
+    REQUIRE(w.write(std::uint16_t(0xAAAA)));
+    REQUIRE(!w.write(std::uint32_t(0xBBBBBBBB)));   // Does not fit; nothing is written
+    REQUIRE(w.size() == 2);
+    REQUIRE(buf[2] == 0);
+    REQUIRE(!w.write(std::uint8_t(1)));             // Would fit, but the frame is already broken
+    REQUIRE(!w.isOk());
+    REQUIRE(w.size() == 2);
+
+    const std::uint16_t values[3] = {1, 2, 3};
+    serial::Writer<> w2(buf);
+    REQUIRE(!w2.write(&values[0], 3));
+    REQUIRE(w2.size() == 0);
+    REQUIRE(!w2.skip(1));
+}
+
+TEST_CASE("SerialArrays")
+{
+    const std::int16_t values[4] = {1, -1, 0x1234, -0x1234};
+    std::uint8_t buf[8]{};
+    serial::Writer<ByteOrder::Big> w(buf);
+    REQUIRE(w.write(&values[0], 4));
+    REQUIRE(!w.write(&values[0], 1));
+    REQUIRE(buf[0] == 0x00);
+    REQUIRE(buf[1] == 0x01);
+    REQUIRE(buf[4] == 0x12);
+    REQUIRE(buf[5] == 0x34);
+
+    std::int16_t out[4]{};
+    serial::Reader<ByteOrder::Big> r(buf);
+    REQUIRE(r.read(&out[0], 4));
+    REQUIRE(std::vector<std::int16_t>(&out[0], &out[4]) == std::vector<std::int16_t>(&values[0], &values[4]));
+
+    serial::Reader<serial::NativeByteOrder> native(buf);
+    REQUIRE(native.read(&out[0], 4));   // memcpy()
+    REQUIRE(native.isOk());
+    REQUIRE(!native.read(&out[0], 1));
+}
+
+TEST_CASE("SerialLengthPrefixed")
+{
+    std::uint8_t buf[128]{};
+    const Vector<float, 24> state{1.0F, 2.0F, -3.0F};
+    const String<64> status("Nominal");
+    const Vector<std::uint16_t, 300> wide{0x0102, 0x0304};
+
+    serial::Writer<> w(buf);
+    REQUIRE(w.writeLengthPrefixed(state));
+    REQUIRE(w.writeLengthPrefixed(status));
+    REQUIRE(w.writeLengthPrefixed(wide));
+    REQUIRE(w.size() == (1 + 12) + (1 + 7) + (2 + 4));
+    REQUIRE(buf[0] == 3);
+    REQUIRE(buf[13] == 7);
+    REQUIRE(buf[14] == 'N');
+    REQUIRE(buf[21] == 2);              // The 16-bit prefix of the wide vector
+    REQUIRE(buf[22] == 0);
+    REQUIRE(buf[23] == 0x02);
+
+    // Decoded in place; the old contents are replaced
+    Vector<float, 24> state_out{9.0F, 9.0F, 9.0F, 9.0F, 9.0F};
+    String<64> status_out("garbage");
+    Vector<std::uint16_t, 300> wide_out;
+    serial::Reader<> r(buf, w.size());
+    REQUIRE(r.readLengthPrefixed(state_out));
+    REQUIRE(r.readLengthPrefixed(status_out));
+    REQUIRE(r.readLengthPrefixed(wide_out));
+    REQUIRE(r.getRemaining() == 0);
+    REQUIRE(state_out == state);
+    REQUIRE(status_out == status);
+    REQUIRE(wide_out == wide);
+
+    // Same in the big endian byte order
+    serial::Writer<ByteOrder::Big> bw(buf);
+    REQUIRE(bw.writeLengthPrefixed(wide));
+    REQUIRE(buf[0] == 0);
+    REQUIRE(buf[1] == 2);
+    REQUIRE(buf[2] == 0x01);
+    serial::Reader<ByteOrder::Big> br(buf, bw.size());
+    wide_out.clear();
+    REQUIRE(br.readLengthPrefixed(wide_out));
+    REQUIRE(wide_out == wide);
+
+    // The prefix is not written alone if the elements do not fit
+    serial::Writer<> small(buf, 12);
+    REQUIRE(!small.writeLengthPrefixed(state));
+    REQUIRE(small.size() == 0);
+}
+
+TEST_CASE("SerialLengthPrefixedInvalid")
+{
+    // Too long for the container: rejected, the container is not modified
+    const std::uint8_t too_long[] = {5, 'a', 'b', 'c', 'd', 'e'};
+    String<4> s("xy");
+    serial::Reader<> r(too_long);
+    REQUIRE(!r.readLengthPrefixed(s));
+    REQUIRE(s == "xy");
+    REQUIRE(r.getOffset() == 0);
+    REQUIRE(!r.isOk());
+
+    // Incomplete
+    const std::uint8_t incomplete[] = {3, 1, 0, 2};
+    Vector<std::uint16_t, 8> v{7};
+    serial::Reader<> r2(incomplete);
+    REQUIRE(!r2.readLengthPrefixed(v));
+    REQUIRE(v.size() == 1);
+    REQUIRE(v[0] == 7);
+
+    serial::Reader<> empty(nullptr, 0);
+    REQUIRE(!empty.readLengthPrefixed(v));
+}
+
+TEST_CASE("SerialFixed")
+{
+    std::uint8_t buf[64]{};
+    std::memset(buf, 0xEE, sizeof(buf));
+    const String<8> name("abc");
+    const Vector<std::uint8_t, 4> data{1, 2};
+
+    serial::Writer<> w(buf);
+    REQUIRE(w.writeFixed(name));
+    REQUIRE(w.writeFixed(data));
+    REQUIRE(w.size() == 12);
+    REQUIRE(getBytes(w, buf) == std::vector<std::uint8_t>{'a', 'b', 'c', 0, 0, 0, 0, 0, 1, 2, 0, 0});
+
+    String<8> name_out;
+    Vector<std::uint8_t, 4> data_out;
+    serial::Reader<> r(buf, w.size());
+    REQUIRE(r.readFixed(name_out));
+    REQUIRE(r.readFixed(data_out));
+    REQUIRE(name_out == "abc");
+    REQUIRE(data_out == Vector<std::uint8_t, 4>{1, 2, 0, 0});   // Always full
+
+    // A full string has no terminator
+    const String<4> full("wxyz");
+    serial::Writer<> w2(buf);
+    REQUIRE(w2.writeFixed(full));
+    String<4> full_out;
+    serial::Reader<> r2(buf, w2.size());
+    REQUIRE(r2.readFixed(full_out));
+    REQUIRE(full_out == "wxyz");
+
+    serial::Writer<> tiny(buf, 7);
+    REQUIRE(!tiny.writeFixed(name));
+    REQUIRE(tiny.size() == 0);
+    serial::Reader<> short_reader(buf, 3);
+    REQUIRE(!short_reader.readFixed(full_out));
+    REQUIRE(full_out == "wxyz");
+}
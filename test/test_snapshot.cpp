@@ -0,0 +1,164 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/snapshot.hpp>
+
+// Test-only dependencies
+#include <senoval/string.hpp>
+#include <senoval/vector.hpp>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+namespace
+{
+/// All fields are equal in a consistent copy. The size is not a multiple of the word size.
+template <std::size_t N>
+struct Pattern
+{
+    std::uint16_t values[N]{};
+    std::uint8_t tail = 0;
+
+    explicit Pattern(const std::uint16_t x = 0)
+    {
+        for (auto& v : values)
+        {
+            v = x;
+        }
+        tail = std::uint8_t(x);
+    }
+
+    [[nodiscard]] bool isConsistent() const
+    {
+        for (const auto v : values)
+        {
+            if (v != values[0])
+            {
+                return false;
+            }
+        }
+        return tail == std::uint8_t(values[0]);
+    }
+};
+
+template <typename S, std::size_t N>
+void checkConcurrent()
+{
+    static constexpr std::uint16_t Count = 30000;
+    S snap;
+    std::atomic<bool> done{false};
+    std::atomic<bool> ok{true};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; i++)
+    {
+        readers.emplace_back([&snap, &done, &ok]() {
+            std::uint16_t last = 0;
+            while (!done.load())
+            {
+                const Pattern<N> p = snap.load();
+                ok = ok && p.isConsistent() && (p.values[0] >= last);   // Never goes back in time
+                last = p.values[0];
+            }
+        });
+    }
+    for (std::uint16_t i = 1; i <= Count; i++)
+    {
+        snap.store(Pattern<N>(i));
+        if ((i % 64U) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    done = true;
+    for (auto& t : readers)
+    {
+        t.join();
+    }
+    REQUIRE(ok.load());
+    REQUIRE(snap.load().values[0] == Count);
+    REQUIRE(snap.getGeneration() == Count);
+}
+}
+
+TEST_CASE("Snapshot")
+{
+    Snapshot<std::uint32_t> word;
+    REQUIRE(word.load() == 0);
+    REQUIRE(word.getGeneration() == 0);
+    word.store(123);
+    REQUIRE(word.load() == 123);
+    REQUIRE(word.getGeneration() == 1);
+    std::uint32_t out = 0;
+    REQUIRE(word.tryLoad(out));
+    REQUIRE(out == 123);
+
+    // The strategy depends on the size by default
+    static_assert(sizeof(Snapshot<std::uint32_t>) < sizeof(Snapshot<std::uint32_t, SnapshotStrategy::TripleBuffer>));
+    using State = Vector<float, 24>;
+    Snapshot<State> state(State{1.0F});
+    static_assert(sizeof(state) >= (3 * sizeof(State)));
+    REQUIRE(state.load() == State{1.0F});
+    for (std::uint32_t i = 0; i < 10; i++)
+    {
+        state.store(State{float(i), 2.0F, 3.0F});
+        REQUIRE(state.getGeneration() == (i + 1U));
+        REQUIRE(state.load() == State{float(i), 2.0F, 3.0F});
+    }
+    State state_out;
+    REQUIRE(state.tryLoad(state_out));
+    REQUIRE(state_out.size() == 3);
+
+    Snapshot<String<64>> status("Booting");
+    REQUIRE(status.load() == "Booting");
+    status.store("Nominal");
+    REQUIRE(status.load() == "Nominal");
+
+    Snapshot<String<8>, SnapshotStrategy::SeqLock> small_status;
+    REQUIRE(small_status.load().empty());
+    small_status.store("Warning");
+    REQUIRE(small_status.load() == "Warning");
+}
+
+TEST_CASE("SnapshotThreads")
+{
+    checkConcurrent<Snapshot<Pattern<7>, SnapshotStrategy::SeqLock>, 7>();
+    checkConcurrent<Snapshot<Pattern<7>, SnapshotStrategy::TripleBuffer>, 7>();
+    checkConcurrent<Snapshot<Pattern<100>>, 100>();
+}
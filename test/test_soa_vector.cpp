@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+#include <senoval/soa_vector.hpp>
+
+// Test-only dependencies
+#include <cstdint>
+#include <numeric>
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+TEST_CASE("SoAVector")
+{
+    SoAVector<100, std::uint32_t, float, float, std::uint8_t> soa;
+    REQUIRE(soa.capacity() == 100);
+    REQUIRE(soa.size() == 0);
+    REQUIRE(soa.empty());
+    REQUIRE(soa.field<1>().empty());
+    static_assert(std::is_same_v<decltype(soa)::FieldType<3>, std::uint8_t>);
+
+    // Each field is aligned at the cache line
+    REQUIRE((reinterpret_cast<std::uintptr_t>(soa.data<0>()) % SENOVAL_CACHE_LINE_SIZE) == 0);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(soa.data<1>()) % SENOVAL_CACHE_LINE_SIZE) == 0);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(soa.data<2>()) % SENOVAL_CACHE_LINE_SIZE) == 0);
+    REQUIRE((reinterpret_cast<std::uintptr_t>(soa.data<3>()) % SENOVAL_CACHE_LINE_SIZE) == 0);
+
+    for (std::uint32_t i = 0; i < 10; i++)
+    {
+        soa.push_back(i, float(i) * 0.5F, float(i) * -1.0F, std::uint8_t(i + 100U));
+    }
+    soa.push_back(std::make_tuple(std::uint32_t(10), 5.0F, -10.0F, std::uint8_t(110)));
+    REQUIRE(soa.size() == 11);
+    REQUIRE(!soa.empty());
+
+    // Fields
+    REQUIRE(soa.field<0>().size() == 11);
+    REQUIRE(std::accumulate(soa.field<0>().begin(), soa.field<0>().end(), 0U) == 55U);
+    REQUIRE(soa.field<2>()[3] == Approx(-3.0F));
+    for (float& x : soa.field<1>())
+    {
+        x *= 2.0F;
+    }
+    REQUIRE(soa.field<1>().back() == Approx(10.0F));
+
+    // Rows
+    {
+        auto [t, x, y, n] = soa[4];
+        REQUIRE(t == 4);
+        REQUIRE(x == Approx(4.0F));
+        REQUIRE(y == Approx(-4.0F));
+        REQUIRE(n == 104);
+        t = 40;                     // References
+    }
+    REQUIRE(soa.field<0>()[4] == 40);
+    soa[5] = std::make_tuple(std::uint32_t(50), 1.0F, 2.0F, std::uint8_t(3));
+    REQUIRE(std::get<0>(soa[5]) == 50);
+    REQUIRE(std::get<3>(soa[5]) == 3);
+    REQUIRE(std::get<0>(soa.front()) == 0);
+    REQUIRE(std::get<0>(soa.back()) == 10);
+
+    const auto& const_ref = soa;
+    REQUIRE(std::get<2>(const_ref[5]) == Approx(2.0F));
+    REQUIRE(const_ref.field<3>()[0] == 100);
+    static_assert(std::is_same_v<decltype(const_ref.field<3>()), Span<const std::uint8_t>>);
+
+    // Copy
+    auto copy = soa;
+    REQUIRE(copy.size() == 11);
+    REQUIRE(std::get<0>(copy[5]) == 50);
+
+    soa.pop_back();
+    REQUIRE(soa.size() == 10);
+    REQUIRE(std::get<0>(soa.back()) == 9);
+
+    soa.resize(12);
+    REQUIRE(soa.size() == 12);
+    REQUIRE(std::get<0>(soa[11]) == 0);
+    REQUIRE(std::get<1>(soa[10]) == Approx(0.0F));
+
+    soa.clear();
+    REQUIRE(soa.empty());
+
+    for (std::uint32_t i = 0; i < 100; i++)
+    {
+        soa.push_back(i, 0.0F, 0.0F, std::uint8_t(0));
+    }
+    REQUIRE(soa.size() == 100);
+    REQUIRE(soa.field<0>().back() == 99);
+}
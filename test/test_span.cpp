@@ -0,0 +1,92 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+#include <senoval/span.hpp>
+
+// Test-only dependencies
+#include <senoval/vector.hpp>
+#include <array>
+#include <vector>
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+static_assert(std::is_convertible_v<Span<int>, Span<const int>>);
+static_assert(!std::is_convertible_v<Span<const int>, Span<int>>);
+static_assert(!std::is_convertible_v<const Vector<int, 3>&, Span<int>>);
+static_assert(std::is_convertible_v<const Vector<int, 3>&, Span<const int>>);
+static_assert(!std::is_convertible_v<std::vector<long>&, Span<int>>);
+
+
+TEST_CASE("Span")
+{
+    Span<int> empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.begin() == empty.end());
+
+    int array[] = {1, 2, 3, 4, 5};
+    Span<int> s = array;
+    REQUIRE(s.size() == 5);
+    REQUIRE(s.front() == 1);
+    REQUIRE(s.back() == 5);
+    s[0] = 10;
+    REQUIRE(array[0] == 10);
+
+    REQUIRE(s.subspan(1).size() == 4);
+    REQUIRE(s.subspan(1).front() == 2);
+    REQUIRE(s.subspan(1, 2).back() == 3);
+    REQUIRE(s.subspan(4, 100).size() == 1);
+    REQUIRE(s.subspan(5).empty());
+    REQUIRE(s.first(2).back() == 2);
+    REQUIRE(s.first(10).size() == 5);
+    REQUIRE(s.last(2).front() == 4);
+    REQUIRE(s.last(10).size() == 5);
+
+    Span<const int> cs = s;
+    REQUIRE(cs.data() == &array[0]);
+
+    Vector<int, 10> vec{7, 8, 9};
+    Span<int> vs = vec;
+    REQUIRE(vs.size() == 3);
+    vs[2] = 90;
+    REQUIRE(vec[2] == 90);
+
+    const std::array<int, 2> std_array{{11, 12}};
+    Span<const int> as = std_array;
+    REQUIRE(as.size() == 2);
+    int sum = 0;
+    for (const int x : as)
+    {
+        sum += x;
+    }
+    REQUIRE(sum == 23);
+}
@@ -0,0 +1,144 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/static_map.hpp>
+
+// Test-only dependencies
+#include <senoval/string.hpp>
+#include <cstdlib>
+#include <cstdint>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+namespace
+{
+enum class Command : std::uint8_t
+{
+    Reboot,
+    Status,
+    Get,
+    Set,
+    Save,
+    Erase,
+};
+
+constexpr auto Commands = makeStaticMap<Command>({
+    {"reboot", Command::Reboot},
+    {"status", Command::Status},
+    {"get",    Command::Get},
+    {"set",    Command::Set},
+    {"save",   Command::Save},
+    {"erase",  Command::Erase},
+});
+
+/// Many keys with a common prefix, generated at compile time.
+struct GeneratedKeys
+{
+    static constexpr std::size_t Count = 300;
+    char storage[Count][12]{};
+
+    constexpr GeneratedKeys()
+    {
+        for (std::size_t i = 0; i < Count; i++)
+        {
+            const char src[] = "param.";
+            std::size_t k = 0;
+            for (; src[k] != '\0'; k++)
+            {
+                storage[i][k] = src[k];
+            }
+            std::size_t divisor = 1;
+            while ((i / divisor) >= 10U)
+            {
+                divisor *= 10U;
+            }
+            for (; divisor > 0; divisor /= 10U)
+            {
+                storage[i][k++] = char('0' + ((i / divisor) % 10U));
+            }
+        }
+    }
+};
+
+constexpr GeneratedKeys Generated;
+
+constexpr auto Big = []() {
+    std::pair<StringView, std::size_t> entries[GeneratedKeys::Count]{};
+    for (std::size_t i = 0; i < GeneratedKeys::Count; i++)
+    {
+        entries[i].first = StringView(&Generated.storage[i][0]);     // std::pair::operator= is not constexpr
+        entries[i].second = i;
+    }
+    return makeStaticMap(entries);
+}();
+}
+
+
+TEST_CASE("StaticMap")
+{
+    static_assert(Commands.size() == 6);
+    static_assert(*Commands.get("save") == Command::Save);
+    static_assert(Commands.get("sav") == nullptr);
+    static_assert(Commands.get("") == nullptr);
+    static_assert(Commands.findKey(Command::Erase) == "erase");
+    static_assert(Commands.contains("get"));
+
+    REQUIRE(*Commands.get(String<16>("reboot")) == Command::Reboot);
+    REQUIRE(Commands.find("set")->value == Command::Set);
+    REQUIRE(Commands.find("sets") == Commands.end());
+    REQUIRE(Commands.get("REBOOT") == nullptr);
+
+    std::size_t n = 0;
+    for (const auto& e : Commands)
+    {
+        REQUIRE(Commands.get(e.key) == &e.value);
+        n++;
+    }
+    REQUIRE(n == 6);
+
+    static_assert(sizeof(Big) < (GeneratedKeys::Count * (sizeof(StringView) + sizeof(std::size_t) + 2U)));
+    for (std::size_t i = 0; i < GeneratedKeys::Count; i++)
+    {
+        const auto key = String(String<16>("param.") + convertIntToString(i));
+        REQUIRE(*Big.get(key) == i);
+        REQUIRE(!Big.contains(String(key + "x")));
+    }
+
+    static constexpr auto Single = makeStaticMap<int>({{"only", 1}});
+    static_assert(*Single.get("only") == 1);
+    static_assert(Single.get("other") == nullptr);
+}
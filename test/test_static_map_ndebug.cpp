@@ -0,0 +1,69 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// Unlike the other tests, this one is built with the assertions disabled, to make sure that the validation
+// of the keys does not depend on them. The value type is unique to this file, so that no template
+// is instantiated differently in the other translation units.
+#ifndef NDEBUG
+# define NDEBUG 1
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/static_map.hpp>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+namespace
+{
+enum class Level : std::uint8_t
+{
+    Debug,
+    Info,
+    Warning,
+    Error,
+};
+
+constexpr auto Levels = makeStaticMap<Level>({
+    {"debug",   Level::Debug},
+    {"info",    Level::Info},
+    {"warning", Level::Warning},
+    {"error",   Level::Error},
+});
+}
+
+TEST_CASE("StaticMapNDEBUG")
+{
+    static_assert(*Levels.get("warning") == Level::Warning);
+    static_assert(Levels.findKey(Level::Info) == "info");
+    static_assert(!Levels.contains("fatal"));
+    REQUIRE(*Levels.get("debug") == Level::Debug);
+    REQUIRE(*Levels.get("error") == Level::Error);
+}
@@ -36,6 +36,13 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
 
 // Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
 // that slows things down.
@@ -80,6 +87,44 @@ TEST_CASE("IntToString")
 
     REQUIRE(intToStringHelper<10, std::int64_t>(9223372036854775807LL)  ==  "9223372036854775807");
     REQUIRE(intToStringHelper<10, std::int64_t>(-9223372036854775807LL) == "-9223372036854775807");
+    REQUIRE(intToStringHelper<10, std::int64_t>(std::numeric_limits<std::int64_t>::min()) ==
+            "-9223372036854775808");
+    REQUIRE(intToStringHelper<10, std::uint64_t>(18446744073709551615ULL) == "18446744073709551615");
+
+    REQUIRE(intToStringHelper(true) == "1");
+    REQUIRE(intToStringHelper(false) == "0");
+
+    REQUIRE(intToStringHelper<8>(-8) == "-10");
+    REQUIRE(intToStringHelper<16, std::uint32_t>(0xDEADBEEFU) == "deadbeef");
+    REQUIRE(intToStringHelper<16, std::int8_t>(-128) == "-80");
+    REQUIRE(intToStringHelper<2, std::uint8_t>(255) == "11111111");
+    REQUIRE(intToStringHelper<36>(35) == "z");
+    REQUIRE(intToStringHelper<3>(-10) == "-101");
+
+    // Zero padding
+    REQUIRE(String<20>(convertIntToString<16>(0xABU, 4)) == "00ab");
+    REQUIRE(String<20>(convertIntToString(-42, 5)) == "-00042");
+    REQUIRE(String<20>(convertIntToString(12345, 3)) == "12345");
+    REQUIRE(String<20>(convertIntToString<10, std::uint8_t>(7, 100)) == "007");     // Limited by the type
+    REQUIRE(String<20>(convertIntToString<2, std::uint8_t>(5, 8)) == "00000101");
+
+    static_assert(String<20>(convertIntToString(-1234567)) == "-1234567");
+    static_assert(String<20>(convertIntToString<16>(0xBEEFU, 8)) == "0000beef");
+
+    // Cross-check against the standard library
+    for (std::int64_t i = -100000; i <= 100000; i += 7)
+    {
+        REQUIRE(std::string(convertIntToString(i).c_str()) == std::to_string(i));
+
+        const auto u = std::uint32_t(i * 40503);
+        char buf[40]{};
+        (void) std::snprintf(&buf[0], sizeof(buf), "%x", unsigned(u));
+        REQUIRE(std::string(convertIntToString<16>(u).c_str()) == &buf[0]);
+        (void) std::snprintf(&buf[0], sizeof(buf), "%o", unsigned(u));
+        REQUIRE(std::string(convertIntToString<8>(u).c_str()) == &buf[0]);
+        (void) std::snprintf(&buf[0], sizeof(buf), "%010u", unsigned(u));
+        REQUIRE(std::string(convertIntToString(u, 10).c_str()) == &buf[0]);
+    }
 }
 
 
@@ -148,7 +193,7 @@ TEST_CASE("String")
     REQUIRE(s.toLowerCase() == "hello/*-12");
     REQUIRE("HELLO/*-12" == s.toUpperCase());
 
-    auto s2 = s + String<10>(" World!");
+    auto s2 = String(s + String<10>(" World!"));
     REQUIRE(s2.capacity() == 20);
     REQUIRE(s2.max_size() == 20);
     REQUIRE(s2.size() == 17);
@@ -168,3 +213,608 @@ TEST_CASE("String")
     *s.data() = 'J';
     REQUIRE(s == "JElLo/*-12");
 }
+
+
+TEST_CASE("StringAppend")
+{
+    String<8> s;
+    s.append("abc", 2);
+    REQUIRE(s == "ab");
+    REQUIRE(s.size() == 2);
+
+    s.append(std::string_view("cdef"));
+    REQUIRE(s == "abcdef");
+
+    s.append(std::string("ghijkl"));    // Truncated
+    REQUIRE(s == "abcdefgh");
+    REQUIRE(s.size() == 8);
+    REQUIRE(*s.end() == '\0');
+
+    s.clear();
+    s += String<3>("123");
+    s += std::string_view("45");
+    s += convertIntToString(678);
+    REQUIRE(s == "12345678");
+
+    // The source is not required to be null-terminated as long as it does not fit
+    const char unterminated[] = {'x', 'y', 'z', 'w'};
+    String<3> s2(unterminated);
+    REQUIRE(s2 == "xyz");
+
+    const char* const p = "qwerty";
+    String<10> s3(p + 1, p + 4);
+    REQUIRE(s3 == "wer");
+
+    s3 = std::string_view("asdfghjklzxcvbnm");
+    REQUIRE(s3 == "asdfghjklz");
+
+    // Assignment from a suffix of the same string; the source and destination overlap
+    s3 = s3.c_str() + 1;
+    REQUIRE(s3 == "sdfghjklz");
+    s3 = s3.view().substr(3);
+    REQUIRE(s3 == "ghjklz");
+    REQUIRE(s3.size() == 6);
+}
+
+
+TEST_CASE("StringConcatenation")
+{
+    const String<4> a("ab");
+    const String<6> b("cdef");
+
+    const auto c = a + ":" + b + "\n" + String<5>("xyz");   // Temporary operands are moved into the expression
+    static_assert(decltype(c)::Capacity == 15);
+    REQUIRE(c == "ab:cdef\nxyz");
+    REQUIRE("ab:cdef\nxyz" == c);
+    REQUIRE(c != "ab:cdef");
+
+    const String<15> s1 = c;
+    REQUIRE(s1 == "ab:cdef\nxyz");
+    REQUIRE(s1 == c);
+
+    auto s2 = String(a + b);
+    static_assert(decltype(s2)::Capacity == 10);
+    REQUIRE(s2 == "abcdef");
+
+    String<6> s3 = a + b + b;     // Truncated
+    REQUIRE(s3 == "abcdef");
+
+    // The destination is also an operand
+    s2 = "[" + s2 + "]";
+    REQUIRE(s2 == "[abcdef]");
+    s2 += s2 + "?";
+    REQUIRE(s2 == "[abcdef][a");
+    s2 = s2.c_str() + 1 + a;
+    REQUIRE(s2 == "abcdef][aa");
+    s2 = a + s2;
+    REQUIRE(s2 == "ababcdef][");
+}
+
+
+namespace
+{
+
+constexpr String<32> makeBanner()
+{
+    String<32> out("Senoval");
+    out += ' ';
+    out += String<4>("v1.0").toUpperCase();
+    out = "[" + out + "]";
+    return out;
+}
+
+}
+
+TEST_CASE("StringConstexpr")
+{
+    static constexpr String<8> Empty;
+    static_assert(Empty.empty());
+    static_assert(Empty == "");     // NOLINT
+
+    static constexpr String<8> Hello("Hello");
+    static_assert(Hello.size() == 5);
+    static_assert(Hello == "Hello");
+    static_assert(Hello != "Hell");
+    static_assert(Hello != "Hello!");
+    static_assert("Hello" == Hello);
+    static_assert(Hello[1] == 'e');
+    static_assert(Hello.front() == 'H');
+    static_assert(Hello.back() == 'o');
+    static_assert(Hello.toLowerCase() == "hello");
+    static_assert(Hello.toUpperCase() == "HELLO");
+    static_assert(Hello == String<5>("Hello"));
+    static_assert(Hello != String<5>("World"));
+
+    static constexpr auto Joined = String(Hello + ", " + String<6>("world!"));
+    static_assert(Joined.capacity() == 14);
+    static_assert(Joined == "Hello, world!");
+
+    static constexpr auto Banner = makeBanner();
+    static_assert(Banner == "[Senoval V1.0]");
+    REQUIRE(Banner == "[Senoval V1.0]");
+
+    // A lookup table residing in ROM
+    static constexpr String<12> Table[] = {"motor.kp", "motor.ki", "motor.kd"};
+    static_assert(Table[1] == "motor.ki");
+    static_assert(Table[2].size() == 8);
+    REQUIRE(Table[0] == "motor.kp");
+}
+
+
+namespace
+{
+
+template <std::int8_t Precision = -1, typename T>
+std::string floatToStdString(const T value)
+{
+    const auto result = convertFloatToString<Precision>(value);
+    REQUIRE(result.size() <= result.capacity());
+    return std::string(result.c_str());
+}
+
+}
+
+TEST_CASE("FloatToString")
+{
+    REQUIRE(floatToStdString(0.0) == "0");
+    REQUIRE(floatToStdString(-0.0) == "-0");
+    REQUIRE(floatToStdString(1.0) == "1");
+    REQUIRE(floatToStdString(0.1) == "0.1");
+    REQUIRE(floatToStdString(0.1F) == "0.1");
+    REQUIRE(floatToStdString(-123.456) == "-123.456");
+    REQUIRE(floatToStdString(100.0F) == "100");
+    REQUIRE(floatToStdString(0.001) == "0.001");
+    REQUIRE(floatToStdString(-1.5e-7) == "-1.5e-7");
+    REQUIRE(floatToStdString(1e300) == "1e+300");
+    REQUIRE(floatToStdString(1e17) == "1e+17");
+    REQUIRE(floatToStdString(12345678901234567.0) == "12345678901234568");
+    REQUIRE(floatToStdString(5e-324) == "5e-324");
+    REQUIRE(floatToStdString(1.7976931348623157e308) == "1.7976931348623157e+308");
+    REQUIRE(floatToStdString(3.4028235e38F) == "3.4028235e+38");
+    REQUIRE(floatToStdString(1e-45F) == "1e-45");
+    REQUIRE(floatToStdString(std::numeric_limits<double>::infinity()) == "inf");
+    REQUIRE(floatToStdString(-std::numeric_limits<float>::infinity()) == "-inf");
+    REQUIRE(floatToStdString(std::numeric_limits<double>::quiet_NaN()) == "nan");
+
+    REQUIRE(floatToStdString<3>(3.14159) == "3.142");
+    REQUIRE(floatToStdString<0>(-2.5) == "-3");
+    REQUIRE(floatToStdString<0>(0.4) == "0");
+    REQUIRE(floatToStdString<2>(0.125) == "0.13");
+    REQUIRE(floatToStdString<2>(9.996) == "10.00");
+    REQUIRE(floatToStdString<1>(0.96) == "1.0");
+    REQUIRE(floatToStdString<3>(0.0006) == "0.001");
+    REQUIRE(floatToStdString<3>(0.0004) == "0.000");
+    REQUIRE(floatToStdString<3>(-0.0004) == "-0.000");
+    REQUIRE(floatToStdString<4>(0.0) == "0.0000");
+    REQUIRE(floatToStdString<2>(123.0F) == "123.00");
+    REQUIRE(floatToStdString<2>(1e300) == "1.00e+300");
+    REQUIRE(floatToStdString<1>(9.99e20) == "1.0e+21");
+    REQUIRE(floatToStdString<3>(std::numeric_limits<float>::infinity()) == "inf");
+
+    // Round trip and cross-check against the C library
+    std::mt19937_64 rng(42);    // NOLINT
+    for (int i = 0; i < 20000; i++)
+    {
+        double d = 0;
+        do
+        {
+            const std::uint64_t bits = rng();
+            std::memcpy(&d, &bits, sizeof(d));
+        }
+        while (!std::isfinite(d));
+        const auto as_str = floatToStdString(d);
+        double parsed = 0;
+        REQUIRE(std::sscanf(as_str.c_str(), "%lf", &parsed) == 1);
+        REQUIRE(std::memcmp(&parsed, &d, sizeof(d)) == 0);
+
+        float f = 0;
+        do
+        {
+            const auto bits = std::uint32_t(rng());
+            std::memcpy(&f, &bits, sizeof(f));
+        }
+        while (!std::isfinite(f));
+        const float parsed_float = std::strtof(floatToStdString(f).c_str(), nullptr);
+        REQUIRE(std::memcmp(&parsed_float, &f, sizeof(f)) == 0);
+
+        // Moderate magnitudes are unlikely to hit exact decimal ties, so the output must match printf().
+        const double moderate = double(std::int64_t(rng() % 2000000001ULL) - 1000000000LL) / 1000.0 / 7.0;
+        char buf[64]{};
+        (void) std::snprintf(&buf[0], sizeof(buf), "%.3f", moderate);
+        REQUIRE(floatToStdString<3>(moderate) == &buf[0]);
+        (void) std::snprintf(&buf[0], sizeof(buf), "%.6f", moderate);
+        REQUIRE(floatToStdString<6>(moderate) == &buf[0]);
+    }
+}
+
+
+TEST_CASE("ParseInt")
+{
+    static_assert(parseInt<int>("123").value == 123);
+    static_assert(parseInt<std::int8_t>("-128").value == -128);
+    static_assert(parseInt<std::int8_t>("-129").error == ParseError::Overflow);
+    static_assert(parseInt<std::uint16_t, 16>("BeeF").value == 0xBEEF);
+
+    REQUIRE(parseInt<int>("0").value == 0);
+    REQUIRE(parseInt<int>("+42").value == 42);
+    REQUIRE(parseInt<int>("-42").value == -42);
+    REQUIRE(parseInt<int>("-42"));
+    REQUIRE(parseInt<int>("0000000000000000000000000042").value == 42);
+    REQUIRE(parseInt<std::int32_t>("2147483647").value == 2147483647);
+    REQUIRE(parseInt<std::int32_t>("-2147483648").value == std::numeric_limits<std::int32_t>::min());
+    REQUIRE(parseInt<std::uint64_t>("18446744073709551615").value == 18446744073709551615ULL);
+    REQUIRE(parseInt<std::int64_t>("-9223372036854775808").value == std::numeric_limits<std::int64_t>::min());
+    REQUIRE(parseInt<std::uint8_t, 2>("11111111").value == 255);
+    REQUIRE(parseInt<std::int32_t, 36>("-zz").value == -1295);
+    REQUIRE(parseInt<std::uint32_t, 8>("777").value == 511);
+
+    const auto overflow = parseInt<std::int32_t>("2147483648");
+    REQUIRE(!overflow);
+    REQUIRE(overflow.error == ParseError::Overflow);
+    REQUIRE(overflow.value == 2147483647);
+    REQUIRE(parseInt<std::int32_t>("-2147483649").value == std::numeric_limits<std::int32_t>::min());
+    REQUIRE(parseInt<std::uint64_t>("18446744073709551616").error == ParseError::Overflow);
+    REQUIRE(parseInt<std::uint8_t>("256").error == ParseError::Overflow);
+    REQUIRE(parseInt<std::uint8_t>("99999999999999999999999").error == ParseError::Overflow);
+    REQUIRE(parseInt<std::uint8_t>("99999999999x").error == ParseError::Malformed);
+
+    REQUIRE(parseInt<int>("").error == ParseError::Empty);
+    REQUIRE(parseInt<int>("-").error == ParseError::Malformed);
+    REQUIRE(parseInt<int>("12a").error == ParseError::Malformed);
+    REQUIRE(parseInt<int>(" 12").error == ParseError::Malformed);
+    REQUIRE(parseInt<unsigned>("-1").error == ParseError::Malformed);
+    REQUIRE(parseInt<int, 16>("0x10").error == ParseError::Malformed);
+
+    // Works on tokens of a String without copying
+    const String<32> line("set 16 -5");
+    auto it = line.view().tokenize().begin();
+    ++it;
+    REQUIRE(parseInt<std::uint8_t>(*it++).value == 16);
+    REQUIRE(parseInt<std::int8_t>(*it).value == -5);
+
+    for (std::int64_t i = -100000; i <= 100000; i += 13)
+    {
+        REQUIRE(parseInt<std::int32_t>(convertIntToString(i).c_str()).value == i);
+        REQUIRE(parseInt<std::uint64_t, 16>(convertIntToString<16>(std::uint64_t(i * i * i)).c_str()).value ==
+                std::uint64_t(i * i * i));
+    }
+}
+
+
+TEST_CASE("ParseFloat")
+{
+    REQUIRE(parseFloat<double>("0").value == Approx(0.0));
+    REQUIRE(parseFloat<double>("-0").value == Approx(0.0));
+    REQUIRE(std::signbit(parseFloat<double>("-0").value));
+    REQUIRE(parseFloat<double>("1.5").value == Approx(1.5));
+    REQUIRE(parseFloat<double>(".5").value == Approx(0.5));
+    REQUIRE(parseFloat<double>("5.").value == Approx(5.0));
+    REQUIRE(parseFloat<float>("-1.25e-3").value == Approx(-1.25e-3F));
+    REQUIRE(parseFloat<double>("1E+10").value == Approx(1e10));
+    REQUIRE(parseFloat<double>("0.12").value == Approx(0.12));
+    REQUIRE(std::isinf(parseFloat<double>("-Infinity").value));
+    REQUIRE(parseFloat<double>("-inf").value < 0);
+    REQUIRE(std::isnan(parseFloat<float>("NaN").value));
+
+    REQUIRE(parseFloat<double>("").error == ParseError::Empty);
+    REQUIRE(parseFloat<double>(".").error == ParseError::Malformed);
+    REQUIRE(parseFloat<double>("-").error == ParseError::Malformed);
+    REQUIRE(parseFloat<double>("1e").error == ParseError::Malformed);
+    REQUIRE(parseFloat<double>("1e+").error == ParseError::Malformed);
+    REQUIRE(parseFloat<double>("1.2.3").error == ParseError::Malformed);
+    REQUIRE(parseFloat<double>("1,2").error == ParseError::Malformed);
+    REQUIRE(parseFloat<double>("0x10").error == ParseError::Malformed);
+
+    REQUIRE(parseFloat<double>("1e309").error == ParseError::Overflow);
+    REQUIRE(std::isinf(parseFloat<double>("1e309").value));
+    REQUIRE(parseFloat<float>("-1e39").error == ParseError::Overflow);
+    REQUIRE(parseFloat<float>("-1e39").value < 0);
+    REQUIRE(parseFloat<double>("1e-400"));
+    REQUIRE(parseFloat<double>("1e-400").value == Approx(0.0));
+    REQUIRE(parseFloat<double>("1e99999999999999").error == ParseError::Overflow);
+
+    // The result must match the C library exactly, except for rare halfway cases in the slow path
+    const auto check = [](const char* const str) {
+        const double d = parseFloat<double>(str).value;
+        const double ref_d = std::strtod(str, nullptr);
+        std::int64_t bits_d = 0;
+        std::int64_t ref_bits_d = 0;
+        std::memcpy(&bits_d, &d, sizeof(d));
+        std::memcpy(&ref_bits_d, &ref_d, sizeof(d));
+        const float f = parseFloat<float>(str).value;
+        const float ref_f = std::strtof(str, nullptr);
+        std::int32_t bits_f = 0;
+        std::int32_t ref_bits_f = 0;
+        std::memcpy(&bits_f, &f, sizeof(f));
+        std::memcpy(&ref_bits_f, &ref_f, sizeof(f));
+        INFO(str);
+        REQUIRE(std::abs(bits_d - ref_bits_d) <= 1);
+        REQUIRE(std::abs(bits_f - ref_bits_f) <= 1);
+        return (bits_d == ref_bits_d) && (bits_f == ref_bits_f);
+    };
+
+    REQUIRE(check("5e-324"));
+    REQUIRE(check("2.2250738585072014e-308"));
+    REQUIRE(check("1.7976931348623157e308"));
+    REQUIRE(check("1.4e-45"));
+    REQUIRE(check("3.4028235e38"));
+    REQUIRE(check("123456789012345678901234567890"));
+    REQUIRE(check("0.000000000000000000000000000000000000000000001"));
+
+    std::mt19937_64 rng(42);    // NOLINT
+    int inexact = 0;
+    for (int i = 0; i < 20000; i++)
+    {
+        // Short decimals, the typical case; these must always be exact
+        char buf[64]{};
+        (void) std::snprintf(&buf[0], sizeof(buf), "%.*f",
+                             int(rng() % 7U),
+                             double(std::int64_t(rng() % 2000000001ULL) - 1000000000LL) / 1000.0);
+        REQUIRE(check(&buf[0]));
+
+        // Arbitrary doubles with all digits
+        double d = 0;
+        do
+        {
+            const std::uint64_t bits = rng();
+            std::memcpy(&d, &bits, sizeof(d));
+        }
+        while (!std::isfinite(d));
+        (void) std::snprintf(&buf[0], sizeof(buf), "%.17g", d);
+        inexact += check(&buf[0]) ? 0 : 1;
+        REQUIRE(parseFloat<double>(convertFloatToString(d).c_str()).value == Approx(d));
+    }
+    REQUIRE(inexact < 100);     // Less than half a percent
+}
+
+
+TEST_CASE("StringCaseFolding")
+{
+    static_assert(String<8>("MiXeD").equalsIgnoreCase("mixed"));
+    static_assert(!String<8>("MiXeD").equalsIgnoreCase("mixer"));
+    static_assert([]() {
+        String<48> s("The Quick Brown Fox Jumps Over The Lazy Dog");
+        s.makeUpperCase();
+        return s == "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG";
+    }());
+
+    // Every byte value at every position and alignment must match the scalar reference
+    char src[300]{};
+    for (std::size_t i = 0; i < sizeof(src); i++)
+    {
+        src[i] = char(std::uint8_t(i));
+    }
+    for (std::size_t offset = 0; offset < 45; offset++)
+    {
+        String<256> s(&src[offset], &src[offset + 255]);
+        REQUIRE(s.size() == 255);       // No zero bytes inside
+        const auto lower = s.toLowerCase();
+        const auto upper = s.toUpperCase();
+        for (std::size_t i = 0; i < s.size(); i++)
+        {
+            const auto c = static_cast<unsigned char>(s[i]);
+            REQUIRE(lower[i] == ((c >= 'A' && c <= 'Z') ? char(c + 32) : char(c)));
+            REQUIRE(upper[i] == ((c >= 'a' && c <= 'z') ? char(c - 32) : char(c)));
+        }
+        REQUIRE(lower.equalsIgnoreCase(upper));
+        REQUIRE(s.equalsIgnoreCase(lower));
+        s.makeLowerCase();
+        REQUIRE(s == lower);
+        s.makeUpperCase();
+        REQUIRE(s == upper);
+    }
+
+    // Unequal in a single position, which can be anywhere
+    const String<40> ref("parameter.name.that_is_fairly_long_0123");
+    for (std::size_t i = 0; i < ref.size(); i++)
+    {
+        auto other = ref.toUpperCase();
+        REQUIRE(ref.equalsIgnoreCase(other));
+        other[i] = char(other[i] ^ 0x20);
+        REQUIRE(ref.equalsIgnoreCase(other) == (std::isalpha(other[i]) != 0));
+        other[i] = '\x7F';
+        REQUIRE(!ref.equalsIgnoreCase(other));
+    }
+    REQUIRE(!ref.equalsIgnoreCase("parameter"));
+    REQUIRE(String<4>().equalsIgnoreCase(""));
+    REQUIRE(!String<4>("[").equalsIgnoreCase("{"));     // Differ by the case bit only
+    REQUIRE(!String<4>("@").equalsIgnoreCase("`"));
+}
+
+
+TEST_CASE("StringEqualityAndHash")
+{
+    const String<8> s("abc");
+    REQUIRE(s == "abc");
+    REQUIRE(s != "ab");
+    REQUIRE(s != "abcd");
+    REQUIRE(s != "abd");
+    REQUIRE(s != "");
+    REQUIRE(String<8>() == "");
+    REQUIRE(s == std::string("abc"));
+    REQUIRE(s != std::string("abc\0", 4));      // Embedded null is not ignored
+    REQUIRE(s == std::string_view("abc"));
+    REQUIRE(s == StringView("abcdef", 3));
+    REQUIRE(s == String<3>("abc"));
+    REQUIRE(s != String<3>("ab"));
+
+    // A longer string is rejected without being scanned to the end
+    const char unterminated[] = {'a', 'b', 'c', 'd'};
+    REQUIRE(s != &unterminated[0]);
+
+    // Reference values of 32-bit FNV-1a
+    static_assert(StringView("").hash() == 0x811C9DC5U);
+    static_assert(StringView("a").hash() == 0xE40C292CU);
+    static_assert(StringView("foobar").hash() == 0xBF9CF968U);
+    static_assert(String<8>("foobar").hash() == StringView("foobar").hash());
+
+    // Usable in case labels
+    const auto classify = [](const StringView name) {
+        switch (name.hash())
+        {
+        case StringView("kp").hash(): return 1;
+        case StringView("ki").hash(): return 2;
+        default: return 0;
+        }
+    };
+    REQUIRE(classify(String<8>("ki")) == 2);
+    REQUIRE(classify("kd") == 0);
+
+    REQUIRE(std::hash<String<8>>()(s) == std::hash<StringView>()("abc"));
+    REQUIRE(std::hash<String<8>>()(s) != std::hash<String<8>>()(String<8>("abd")));
+}
+
+
+TEST_CASE("StringFootprint")
+{
+    static_assert(sizeof(String<15>) == 17);
+    static_assert(sizeof(String<254>) == 256);
+    static_assert(sizeof(String<300>) == 304);
+    static_assert(sizeof(String<70000>) == 70008);
+    static_assert(std::is_same_v<decltype(String<15>().size()), std::size_t>);
+
+    String<255> s;
+    s.resize(255, 'x');
+    REQUIRE(s.size() == 255);
+    s.push_back('y');
+    REQUIRE(s.size() == 255);
+    REQUIRE(s.back() == 'x');
+    s.append("abc");
+    REQUIRE(s.size() == 255);
+}
+
+/// Compiled once for all capacities.
+static void appendGreeting(const StringRef out, const StringView name)
+{
+    out += "Hello, ";
+    out += name;
+    out += '!';
+}
+
+static constexpr String<8> makeShouting()
+{
+    String<8> s("abc");
+    const StringRef ref(s);
+    ref.makeUpperCase();
+    ref.append("defghijk");     // Truncated
+    return s;
+}
+
+TEST_CASE("StringRef")
+{
+    static_assert(makeShouting() == "ABCdefgh");
+
+    String<100> big;
+    String<10> small;
+    String<300> wide;
+    appendGreeting(big, "world");
+    appendGreeting(small, "world");
+    appendGreeting(wide, "world");
+    REQUIRE(big == "Hello, world!");
+    REQUIRE(small == "Hello, wor");
+    REQUIRE(small.size() == 10);
+    REQUIRE(wide == big);
+
+    const StringRef ref(big);
+    REQUIRE(ref.capacity() == 100);
+    REQUIRE(ref.size() == 13);
+    REQUIRE(!ref.empty());
+    REQUIRE(ref == "Hello, world!");
+    REQUIRE(ref != "Hello");
+    REQUIRE(ref.view() == big.view());
+    REQUIRE(ref.c_str() == big.c_str());
+    REQUIRE(ref.equalsIgnoreCase("HELLO, WORLD!"));
+    REQUIRE(std::string(ref.begin(), ref.end()) == "Hello, world!");
+
+    ref.makeLowerCase();
+    REQUIRE(big == "hello, world!");
+    ref[0] = 'j';
+    REQUIRE(big == "jello, world!");
+    ref.pop_back();
+    REQUIRE(big == "jello, world");
+    ref.push_back('?');
+    REQUIRE(big == "jello, world?");
+    ref.resize(5);
+    REQUIRE(big == "jello");
+    REQUIRE(big.c_str()[5] == '\0');
+    ref.resize(7, '.');
+    REQUIRE(big == "jello..");
+    ref.resize(1000, 'x');                      // Clamped
+    REQUIRE(big.size() == 100);
+    ref.clear();
+    REQUIRE(big.empty());
+    REQUIRE(big.c_str()[0] == '\0');
+
+    // The length type is erased; every width works
+    wide.resize(290, 'a');
+    StringRef(wide).append("0123456789abc");
+    REQUIRE(wide.size() == 300);
+    REQUIRE(wide.view().substr(290) == "0123456789");
+
+    // A raw buffer
+    char buffer[6]{};
+    std::uint8_t length = 0;
+    const StringRef raw(buffer, 5, &length);
+    raw.append(std::string("abcdefg"));
+    REQUIRE(length == 5);
+    REQUIRE(std::strcmp(buffer, "abcde") == 0);
+
+    // Forwarded from String
+    small.resize(20, 'z');
+    REQUIRE(small.size() == 10);
+    REQUIRE(String<4>("aBc").toUpperCase() == "ABC");
+    REQUIRE(String<4>("aBc").toLowerCase() == "abc");
+}
+
+static std::vector<OverflowKind> g_string_overflows;
+
+static void recordStringOverflow(const OverflowKind kind)
+{
+    g_string_overflows.push_back(kind);
+}
+
+TEST_CASE("StringOverflowPolicy")
+{
+    static_assert(sizeof(String<15, overflow::Unchecked>) == sizeof(String<15>));
+    static_assert(sizeof(String<15, overflow::Callback<&recordStringOverflow>>) == sizeof(String<15>));
+    static_assert(String<4, overflow::Unchecked>("ab") == "ab");
+    static_assert(!std::is_convertible_v<String<4>, overflow::Truncate>);    // The policy is not exposed
+
+    // Strings with different policies are interoperable
+    const String<16, overflow::Unchecked> unchecked("Hello");
+    String<16> plain(unchecked);
+    REQUIRE(plain == unchecked);
+    REQUIRE(String<32>(plain + ", " + unchecked) == "Hello, Hello");
+    REQUIRE(std::hash<String<16, overflow::Unchecked>>()(unchecked) == std::hash<String<16>>()(plain));
+
+    String<4, overflow::TruncateAndCount> counted;
+    counted = "ab";
+    REQUIRE(counted.getOverflowPolicy().getCount() == 0);
+    counted += "cde";           // Truncated
+    REQUIRE(counted == "abcd");
+    REQUIRE(counted.getOverflowPolicy().getCount() == 1);
+    counted.push_back('x');
+    counted.resize(10, 'y');
+    counted += String<8>("zz");
+    REQUIRE(counted == "abcd");
+    REQUIRE(counted.getOverflowPolicy().getCount() == 4);
+    counted = counted + "!";    // Overlapping concatenation goes through a temporary; still detected
+    REQUIRE(counted.getOverflowPolicy().getCount() == 5);
+    counted.getOverflowPolicy().resetCount();
+    counted.clear();
+    counted += "abcd";          // Exactly fits
+    REQUIRE(counted.getOverflowPolicy().getCount() == 0);
+
+    g_string_overflows.clear();
+    String<3, overflow::Callback<&recordStringOverflow>> cb("abc");
+    REQUIRE(g_string_overflows.empty());
+    cb.push_back('d');
+    cb.append("efg", 3);
+    REQUIRE(cb[3] == 'c');      // Out of range; the last character is returned
+    cb.clear();
+    REQUIRE(cb.back() == '\0');
+    REQUIRE(g_string_overflows == std::vector<OverflowKind>{OverflowKind::Capacity,
+                                                            OverflowKind::Truncation,
+                                                            OverflowKind::OutOfRange,
+                                                            OverflowKind::OutOfRange});
+}
@@ -0,0 +1,168 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2018 Zubax Robotics
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author: Pavel Kirienko <pavel.kirienko@zubax.com>
+ */
+
+// We want to ensure that assertion checks are enabled when tests are run, for extra safety
+#ifdef NDEBUG
+# undef NDEBUG
+#endif
+
+// The library should be included first in order to ensure that all necessary headers are included in the library itself
+#include <senoval/string_view.hpp>
+#include <senoval/string.hpp>
+
+// Test-only dependencies
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+
+// Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
+// that slows things down.
+// https://github.com/catchorg/Catch2/blob/master/docs/slow-compiles.md
+#include "catch.hpp"
+
+
+using namespace senoval;
+
+
+namespace
+{
+
+std::vector<std::string> collect(const TokenRange& range)
+{
+    std::vector<std::string> out;
+    for (const StringView token : range)
+    {
+        out.emplace_back(token.data(), token.size());
+    }
+    return out;
+}
+
+}
+
+
+TEST_CASE("StringView")
+{
+    constexpr StringView sv("set motor.kp 0.12");
+    static_assert(sv.size() == 17);
+    static_assert(sv.starts_with("set "));
+    static_assert(sv.starts_with('s'));
+    static_assert(!sv.starts_with("get"));
+    static_assert(sv.ends_with("0.12"));
+    static_assert(sv.ends_with('2'));
+    static_assert(!sv.ends_with("0.13"));
+    static_assert(sv.find('m') == 4);
+    static_assert(sv.find(' ', 4) == 12);
+    static_assert(sv.find('x') == StringView::npos);
+    static_assert(sv.find("kp") == 10);
+    static_assert(sv.find("") == 0);
+    static_assert(sv.find("0.123") == StringView::npos);
+    static_assert(sv.rfind(' ') == 12);
+    static_assert(sv.rfind(' ', 11) == 3);
+    static_assert(sv.find_first_of(".,") == 9);
+    static_assert(sv.find_first_not_of("tes") == 3);
+    static_assert(sv.substr(4, 8) == "motor.kp");
+    static_assert(sv.substr(13) == "0.12");
+    static_assert(sv.substr(100).empty());
+    static_assert(sv.contains("motor"));
+    static_assert(StringView("  abc \t").trim() == "abc");
+    static_assert(StringView("   ").trim().empty());
+    static_assert(StringView("abc") < StringView("abd"));
+    static_assert(StringView("ab") < StringView("abc"));
+    static_assert(StringView("abc").compare("abc") == 0);
+    static_assert(StringView() == "");          // NOLINT
+    static_assert(StringView("abc", 2) == "ab");
+
+    StringView x = sv;
+    x.remove_prefix(4);
+    x.remove_suffix(5);
+    REQUIRE(x == "motor.kp");
+    REQUIRE(x.data() == sv.data() + 4);     // No copying
+    x.remove_prefix(100);
+    REQUIRE(x.empty());
+
+    static_assert(StringView("Motor.Kp").equalsIgnoreCase("motor.kP"));
+    REQUIRE(x.equalsIgnoreCase(""));
+    REQUIRE(StringView("SET").equalsIgnoreCase(sv.substr(0, 3)));
+    REQUIRE(!StringView("SET").equalsIgnoreCase(sv.substr(0, 4)));
+
+    const std::string_view stdsv = sv;
+    REQUIRE(stdsv == "set motor.kp 0.12");
+    REQUIRE(StringView(stdsv) == sv);
+}
+
+
+TEST_CASE("StringViewTokens")
+{
+    REQUIRE(collect(StringView("a,,b").split(',')) == std::vector<std::string>{"a", "", "b"});
+    REQUIRE(collect(StringView("a,").split(',')) == std::vector<std::string>{"a", ""});
+    REQUIRE(collect(StringView("").split(',')) == std::vector<std::string>{""});
+    REQUIRE(collect(StringView("abc").split(',')) == std::vector<std::string>{"abc"});
+
+    REQUIRE(collect(StringView("  set motor.kp\t0.12 ").tokenize()) ==
+            std::vector<std::string>{"set", "motor.kp", "0.12"});
+    REQUIRE(collect(StringView("motor.kp").tokenize(".")) == std::vector<std::string>{"motor", "kp"});
+    REQUIRE(collect(StringView("   ").tokenize()).empty());
+    REQUIRE(collect(StringView().tokenize()).empty());
+
+    // Manual parsing
+    const String<40> line("set motor.kp 0.12");
+    auto it = line.view().tokenize().begin();
+    REQUIRE(*it == "set");
+    REQUIRE(it.getRemainder() == " motor.kp 0.12");
+    ++it;
+    REQUIRE(*it == "motor.kp");
+    REQUIRE(it->data() == line.c_str() + 4);
+    it++;
+    REQUIRE(*it == "0.12");
+    REQUIRE(++it == line.view().tokenize().end());
+
+    constexpr auto Range = StringView("x y").tokenize();
+    static_assert(*Range.begin() == "x");
+}
+
+
+TEST_CASE("StringViewString")
+{
+    String<20> s("hello world");
+    const StringView v = s;
+    REQUIRE(v == "hello world");
+    REQUIRE(v.data() == s.c_str());
+    REQUIRE(s == v);
+    REQUIRE(v == s);
+    REQUIRE(s.view().substr(6) == "world");
+
+    String<5> s2(v.substr(6));
+    REQUIRE(s2 == "world");
+    s2 = v.substr(0, 3);
+    REQUIRE(s2 == "hel");
+    s2 += StringView("lo!!!", 2);
+    REQUIRE(s2 == "hello");
+
+    static constexpr String<8> Constant("abc");
+    static_assert(StringView(Constant) == "abc");
+    static_assert(Constant.view().ends_with("bc"));
+}
@@ -36,6 +36,10 @@
 #include <iostream>
 #include <iomanip>
 #include <cmath>
+#include <memory>
+#include <vector>
+#include <list>
+#include <senoval/string.hpp>
 
 // Note that we should NOT define CATCH_CONFIG_MAIN in the same translation unit which also contains tests;
 // that slows things down.
@@ -50,7 +54,7 @@ TEST_CASE("Vector")
 {
     Vector<std::int32_t, 10> vec;
 
-    REQUIRE(sizeof(vec) == 40 + sizeof(std::size_t));
+    REQUIRE(sizeof(vec) == 44);     // The one-byte length is padded to the alignment of the element
     REQUIRE(vec.empty());
     REQUIRE(vec.capacity() == 10);
     REQUIRE(vec.max_size() == 10);
@@ -108,7 +112,7 @@ TEST_CASE("Vector")
 
     const std::int8_t arr[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     const Vector<std::int8_t, 80> vec2(std::begin(arr), std::end(arr));
-    REQUIRE(sizeof(vec2) == 80 + sizeof(std::size_t));
+    REQUIRE(sizeof(vec2) == 81);
     REQUIRE(!vec2.empty());
     REQUIRE(vec2.capacity() == 80);
     REQUIRE(vec2.max_size() == 80);
@@ -187,4 +191,321 @@ TEST_CASE("Vector")
         REQUIRE(vec4[2] == 3);
         REQUIRE(vec4[3] == 4);
     }
+
+    {
+        static_assert(sizeof(Vector<std::uint8_t, 8>) == 9);
+        static_assert(sizeof(Vector<std::uint64_t, 4>) == 40);
+        static_assert(sizeof(Vector<char, 255>) == 256);
+        static_assert(sizeof(Vector<char, 256>) == 258);
+        Vector<char, 255> vec5(255, 'a');
+        REQUIRE(vec5.size() == 255);
+        vec5.resize(3);
+        REQUIRE(vec5.size() == 3);
+    }
+}
+
+
+namespace
+{
+/// Tracks the number of live instances to validate the lifetime management.
+class Counted
+{
+    static inline int live_ = 0;
+    int value_;
+
+public:
+    explicit Counted(const int value) : value_(value) { ++live_; }
+    Counted(const Counted& other) : value_(other.value_) { ++live_; }
+    Counted(Counted&& other) noexcept : value_(other.value_) { other.value_ = -1; ++live_; }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) = default;
+    ~Counted() { --live_; }
+
+    [[nodiscard]] int getValue() const { return value_; }
+    [[nodiscard]] static int getLiveCount() { return live_; }
+};
+}
+
+TEST_CASE("VectorNonTrivial")
+{
+    static_assert(std::is_trivially_copyable_v<Vector<std::int32_t, 4>>);
+    static_assert(!std::is_trivially_copyable_v<Vector<Counted, 4>>);
+    static_assert(sizeof(Vector<Counted, 4>) == 4 * sizeof(Counted) + alignof(Counted));
+
+    {
+        Vector<Counted, 4> vec;
+        REQUIRE(Counted::getLiveCount() == 0);      // Nothing is constructed upfront
+        REQUIRE(vec.emplace_back(1).getValue() == 1);
+        vec.push_back(Counted(2));
+        const Counted c3(3);
+        vec.push_back(c3);
+        REQUIRE(Counted::getLiveCount() == 4);
+        REQUIRE(vec.size() == 3);
+        REQUIRE(vec[1].getValue() == 2);
+        REQUIRE(vec.back().getValue() == 3);
+
+        vec.pop_back();
+        REQUIRE(Counted::getLiveCount() == 3);
+
+        auto copy = vec;
+        REQUIRE(copy.size() == 2);
+        REQUIRE(Counted::getLiveCount() == 5);
+
+        auto moved = std::move(vec);
+        REQUIRE(moved.size() == 2);
+        REQUIRE(moved[0].getValue() == 1);
+        REQUIRE(vec.empty());                       // NOLINT the moved-from vector is left empty
+        REQUIRE(Counted::getLiveCount() == 5);
+
+        copy = moved;
+        REQUIRE(Counted::getLiveCount() == 5);
+        copy.emplace_back(7);
+        moved = std::move(copy);
+        REQUIRE(moved.size() == 3);
+        REQUIRE(moved[2].getValue() == 7);
+        REQUIRE(Counted::getLiveCount() == 4);
+
+        moved.clear();
+        REQUIRE(Counted::getLiveCount() == 1);
+    }
+    REQUIRE(Counted::getLiveCount() == 0);
+
+    {
+        Vector<std::unique_ptr<int>, 3> vec;
+        vec.emplace_back(std::make_unique<int>(42));
+        vec.push_back(std::make_unique<int>(43));
+        auto other = std::move(vec);
+        REQUIRE(other.size() == 2);
+        REQUIRE(*other[0] == 42);
+        REQUIRE(*other.back() == 43);
+    }
+
+    {
+        Vector<String<8>, 4> vec{String<8>("abc"), String<8>("def")};
+        vec.emplace_back("ghi");
+        vec.resize(4, String<8>("x"));
+        REQUIRE(vec.size() == 4);
+        REQUIRE(vec[2] == "ghi");
+        REQUIRE(vec[3] == "x");
+        vec.resize(1);
+        REQUIRE(vec == Vector<String<8>, 2>{String<8>("abc")});
+    }
+}
+
+
+TEST_CASE("VectorBulk")
+{
+    using V = Vector<std::uint8_t, 8>;
+    V vec{1, 2, 3};
+
+    REQUIRE(*vec.insert(vec.begin() + 1, {7, 8}) == 7);
+    REQUIRE(vec == V{1, 7, 8, 2, 3});
+    vec.insert(vec.end(), 2, 9);
+    REQUIRE(vec == V{1, 7, 8, 2, 3, 9, 9});
+    vec.insert(vec.begin(), vec.back());          // Aliasing the inserted value is fine
+    REQUIRE(vec == V{9, 1, 7, 8, 2, 3, 9, 9});
+    REQUIRE(vec.size() == vec.capacity());
+
+    // Once full, nothing is inserted, and nothing is dropped
+    const std::uint8_t extra[] = {100, 101};
+    vec.insert(vec.begin(), std::begin(extra), std::end(extra));
+    vec.insert(vec.begin(), 5, 100);
+    REQUIRE(vec == V{9, 1, 7, 8, 2, 3, 9, 9});
+
+    REQUIRE(*vec.erase(vec.begin() + 1, vec.begin() + 3) == 8);
+    REQUIRE(vec == V{9, 8, 2, 3, 9, 9});
+    const auto after_last = vec.erase(vec.end() - 1);
+    REQUIRE(after_last == vec.end());
+    REQUIRE(vec.erase(vec.begin(), vec.begin()) == vec.begin());
+    REQUIRE(vec == V{9, 8, 2, 3, 9});
+
+    // Partial insertion when the range does not fit
+    vec.insert(vec.begin() + 1, {40, 41, 42, 43, 44});
+    REQUIRE(vec == V{9, 40, 41, 42, 8, 2, 3, 9});
+
+    vec.assign({5, 6});
+    REQUIRE(vec == V{5, 6});
+    vec.assign(3, vec[1]);
+    REQUIRE(vec == V{6, 6, 6});
+    const std::list<std::uint8_t> lst{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    vec.assign(lst.begin(), lst.end());             // Not contiguous
+    REQUIRE(vec == V{1, 2, 3, 4, 5, 6, 7, 8});
+
+    vec.clear();
+    vec.append(std::vector<std::uint8_t>{1, 2, 3});
+    vec.append(lst);
+    REQUIRE(vec == V{1, 2, 3, 1, 2, 3, 4, 5});
+    vec.resize(2);
+    vec.resize(4, 0xFF);
+    REQUIRE(vec == V{1, 2, 0xFF, 0xFF});
+
+    // Same for non-trivial types
+    using S = Vector<std::unique_ptr<int>, 4>;
+    S ptrs;
+    ptrs.emplace_back(std::make_unique<int>(1));
+    ptrs.emplace_back(std::make_unique<int>(3));
+    REQUIRE(**ptrs.insert(ptrs.begin() + 1, std::make_unique<int>(2)) == 2);
+    REQUIRE(**ptrs.emplace(ptrs.begin(), std::make_unique<int>(0)) == 0);
+    REQUIRE(ptrs.size() == 4);
+    for (int i = 0; i < 4; i++)
+    {
+        REQUIRE(*ptrs[std::size_t(i)] == i);
+    }
+    REQUIRE(**ptrs.erase(ptrs.begin() + 1) == 2);
+    REQUIRE(ptrs.size() == 3);
+    REQUIRE(*ptrs[0] == 0);
+    REQUIRE(*ptrs[1] == 2);
+    REQUIRE(*ptrs[2] == 3);
+    ptrs.erase(ptrs.begin(), ptrs.end());
+    REQUIRE(ptrs.empty());
+
+    Vector<Counted, 6> objs(3, Counted(1));
+    objs.insert(objs.begin() + 1, 5, Counted(2));
+    REQUIRE(objs.size() == 6);
+    REQUIRE(objs[0].getValue() == 1);
+    REQUIRE(objs[1].getValue() == 2);
+    REQUIRE(objs[3].getValue() == 2);
+    REQUIRE(objs[4].getValue() == 1);
+    objs.erase(objs.begin(), objs.begin() + 4);
+    REQUIRE(objs.size() == 2);
+    REQUIRE(Counted::getLiveCount() == 2);
+    objs.assign(1, Counted(3));
+    REQUIRE(Counted::getLiveCount() == 1);
+    REQUIRE(objs.front().getValue() == 3);
+}
+
+/// Compiled once for all capacities.
+static std::size_t appendSquares(const VectorRef<int> out, const int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (out.size() < out.capacity())
+        {
+            out.push_back(i * i);
+        }
+    }
+    return out.size();
+}
+
+TEST_CASE("VectorRef")
+{
+    Vector<int, 4> small;
+    Vector<int, 1000> big;
+    REQUIRE(appendSquares(small, 10) == 4);
+    REQUIRE(appendSquares(big, 10) == 10);
+    REQUIRE(small == std::vector<int>{0, 1, 4, 9});
+    REQUIRE(big.size() == 10);
+    REQUIRE(big.back() == 81);
+
+    Vector<int, 300> wide;
+    const VectorRef<int> ref(wide);
+    REQUIRE(ref.capacity() == 300);
+    REQUIRE(ref.empty());
+    ref.resize(290, 7);
+    REQUIRE(wide.size() == 290);
+    ref.append(big);                            // Truncated
+    REQUIRE(wide.size() == 300);
+    REQUIRE(wide[290] == 0);
+    REQUIRE(wide[299] == 81);
+    REQUIRE(ref.begin() == wide.begin());
+    REQUIRE(ref.end() == wide.end());
+    (void) ref.erase(ref.begin(), ref.begin() + 289);
+    REQUIRE(wide.size() == 11);
+    REQUIRE(ref.front() == 7);
+    (void) ref.insert(ref.begin() + 1, {5, 6});
+    REQUIRE(wide.size() == 13);
+    REQUIRE(wide[1] == 5);
+    REQUIRE(wide[3] == 0);
+    (void) ref.emplace(ref.end(), 42);
+    REQUIRE(ref.back() == 42);
+    ref.pop_back();
+    ref.assign(3, 1);
+    REQUIRE(wide == std::vector<int>{1, 1, 1});
+    ref.clear();
+    REQUIRE(wide.empty());
+
+    // Non-trivial elements are constructed and destroyed through the reference
+    {
+        Vector<Counted, 8> counted;
+        const VectorRef<Counted> cref(counted);
+        for (int i = 0; i < 5; i++)
+        {
+            (void) cref.emplace_back(i);
+        }
+        REQUIRE(Counted::getLiveCount() == 5);
+        (void) cref.erase(cref.begin() + 1, cref.begin() + 3);
+        REQUIRE(Counted::getLiveCount() == 3);
+        REQUIRE(counted[1].getValue() == 3);
+        (void) cref.insert(cref.begin(), Counted(10));
+        REQUIRE(Counted::getLiveCount() == 4);
+        REQUIRE(counted[0].getValue() == 10);
+        cref.resize(1, Counted(0));
+        REQUIRE(Counted::getLiveCount() == 1);
+    }
+    REQUIRE(Counted::getLiveCount() == 0);
+
+    // A raw buffer
+    float storage[3]{};
+    std::uint8_t length = 0;
+    const VectorRef<float> raw(storage, 3, &length);
+    raw.assign({1.0F, 2.0F, 3.0F, 4.0F});
+    REQUIRE(length == 3);
+    REQUIRE(storage[2] == Approx(3.0F));
+}
+
+static std::vector<OverflowKind> g_vector_overflows;
+
+static void recordVectorOverflow(const OverflowKind kind)
+{
+    g_vector_overflows.push_back(kind);
+}
+
+TEST_CASE("VectorOverflowPolicy")
+{
+    static_assert(sizeof(Vector<std::uint8_t, 7, overflow::Unchecked>) == sizeof(Vector<std::uint8_t, 7>));
+    static_assert(sizeof(Vector<std::uint8_t, 7, overflow::Callback<&recordVectorOverflow>>) ==
+                  sizeof(Vector<std::uint8_t, 7>));
+
+    // No checks at all; the bounds are the responsibility of the caller
+    Vector<int, 4, overflow::Unchecked> unchecked{1, 2};
+    unchecked.push_back(3);
+    unchecked[0] = unchecked.back();
+    REQUIRE(unchecked == std::vector<int>{3, 2, 3});
+    const VectorRef<int> ref(unchecked);
+    REQUIRE(ref.size() == 3);
+
+    Vector<int, 3, overflow::TruncateAndCount> counted{1, 2, 3};
+    REQUIRE(counted.getOverflowPolicy().getCount() == 0);
+    counted.push_back(4);
+    (void) counted.emplace(counted.begin(), 0);
+    counted.insert(counted.end(), 2, 5);
+    counted.append(std::vector<int>{6, 7});
+    counted.resize(5);
+    REQUIRE(counted == std::vector<int>{1, 2, 3});
+    REQUIRE(counted.getOverflowPolicy().getCount() == 5);
+    counted.assign({7, 8, 9, 10});
+    REQUIRE(counted == std::vector<int>{7, 8, 9});
+    REQUIRE(counted.getOverflowPolicy().getCount() == 6);
+    const std::list<int> lst{1, 2, 3, 4};
+    counted.assign(lst.begin(), lst.end());
+    REQUIRE(counted.getOverflowPolicy().getCount() == 7);
+    counted.getOverflowPolicy().resetCount();
+    counted.assign(3, 0);       // Exactly fits
+    REQUIRE(counted.getOverflowPolicy().getCount() == 0);
+
+    g_vector_overflows.clear();
+    Vector<int, 2, overflow::Callback<&recordVectorOverflow>> cb{1, 2, 3};
+    REQUIRE(cb == std::vector<int>{1, 2});
+    REQUIRE(cb.emplace_back(4) == 2);   // Full; the last element is returned
+    REQUIRE(cb[5] == 2);
+    cb.insert(cb.begin(), {8, 9});
+    cb.clear();
+    cb.pop_back();
+    (void) cb.back();
+    REQUIRE(g_vector_overflows == std::vector<OverflowKind>{OverflowKind::Capacity,
+                                                            OverflowKind::Capacity,
+                                                            OverflowKind::OutOfRange,
+                                                            OverflowKind::Truncation,
+                                                            OverflowKind::OutOfRange,
+                                                            OverflowKind::OutOfRange});
 }